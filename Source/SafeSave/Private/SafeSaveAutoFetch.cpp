@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveAutoFetch.h"
+
+#include "SafeSaveCommandRunner.h"
+#include "SafeSaveGitRepository.h"
+#include "SafeSaveGitStatusQuery.h"
+#include "SafeSavePollScheduler.h"
+#include "SafeSaveSettings.h"
+
+FSafeSaveAutoFetch::FSafeSaveAutoFetch(const FSafeSaveCommandRunner& InRunner, const FSafeSaveGitStatusQuery& InGitQuery)
+	: Runner(InRunner)
+	, GitQuery(InGitQuery)
+{
+}
+
+void FSafeSaveAutoFetch::Start(double NowSeconds)
+{
+	LastFetchSeconds = NowSeconds;
+	LastFullFetchSeconds = NowSeconds;
+}
+
+bool FSafeSaveAutoFetch::ConsumeDueFetch(double NowSeconds, const USafeSaveSettings& Settings, const FSafeSavePollScheduler& PollScheduler, bool& bOutFullFetch)
+{
+	const double AutoFetchInterval = PollScheduler.ScaleInterval(FMath::Max(10.0, (double)Settings.AutoFetchIntervalSeconds));
+	if (NowSeconds - LastFetchSeconds < AutoFetchInterval)
+	{
+		return false;
+	}
+
+	const double FullFetchInterval = PollScheduler.ScaleInterval(FMath::Max(0.0, (double)Settings.FullFetchIntervalSeconds));
+	bOutFullFetch = Settings.AutoFetchMode == ESafeSaveAutoFetchMode::AllRemotes
+		|| (FullFetchInterval > 0.0 && NowSeconds - LastFullFetchSeconds >= FullFetchInterval);
+
+	LastFetchSeconds = NowSeconds;
+	if (bOutFullFetch)
+	{
+		LastFullFetchSeconds = NowSeconds;
+	}
+	return true;
+}
+
+FSafeSaveAutoFetch::FResult FSafeSaveAutoFetch::FetchUpstreamIfMoved(const FString& RepoRoot) const
+{
+	FResult Result;
+
+	// Local tracking branches (remote ".") and unreadable configs have nothing cheap to check.
+	FSafeSaveGitRepository::FHeadInfo Head;
+	if (!FSafeSaveGitRepository::ReadHead(RepoRoot, Head) || !Head.bHasUpstream || Head.RemoteName.IsEmpty() || Head.RemoteName == TEXT("."))
+	{
+		return Result;
+	}
+
+	// One round-trip that writes nothing locally: "<oid>\t<ref>".
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+	Result.bSuccess = Runner.RunGit(FString::Printf(TEXT("ls-remote --quiet %s %s"), *Head.RemoteName, *Head.MergeRef), RepoRoot, StdOut, StdErr, ExitCode, true) && ExitCode == 0;
+
+	if (Result.bSuccess)
+	{
+		FString RemoteTip = StdOut.TrimStartAndEnd();
+		int32 TabIndex = INDEX_NONE;
+		if (RemoteTip.FindChar(TEXT('\t'), TabIndex))
+		{
+			RemoteTip.LeftInline(TabIndex);
+		}
+
+		// An empty answer means the branch is gone on the remote; the periodic full fetch prunes it.
+		if (!RemoteTip.IsEmpty() && RemoteTip != Head.UpstreamOid)
+		{
+			const FString NoWriteFetchHead = GitQuery.GetCapabilities(RepoRoot).bNoWriteFetchHead ? TEXT(" --no-write-fetch-head") : TEXT("");
+			const FString FetchArgs = FString::Printf(TEXT("fetch --no-tags%s %s +%s:%s"), *NoWriteFetchHead, *Head.RemoteName, *Head.MergeRef, *Head.UpstreamRef);
+			StdOut.Reset();
+			StdErr.Reset();
+			Result.bSuccess = Runner.RunGit(FetchArgs, RepoRoot, StdOut, StdErr, ExitCode, true) && ExitCode == 0;
+			Result.bFetched = Result.bSuccess;
+		}
+	}
+
+	Result.ErrorText = StdErr.TrimStartAndEnd();
+	return Result;
+}
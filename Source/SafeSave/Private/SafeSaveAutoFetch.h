@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSafeSaveCommandRunner;
+class FSafeSaveGitStatusQuery;
+class FSafeSavePollScheduler;
+class USafeSaveSettings;
+
+/**
+ * Timers for the background fetch and the cheap fetch that runs between full ones: a single ls-remote of the
+ * current upstream branch, followed by a fetch of that branch only when the remote moved.
+ */
+class FSafeSaveAutoFetch
+{
+public:
+	/** Outcome of FetchUpstreamIfMoved, handed from the worker to the game thread. */
+	struct FResult
+	{
+		bool bSuccess = true;
+		/** The upstream moved and was fetched, so the status changed. */
+		bool bFetched = false;
+		FString ErrorText;
+	};
+
+	FSafeSaveAutoFetch(const FSafeSaveCommandRunner& InRunner, const FSafeSaveGitStatusQuery& InGitQuery);
+
+	/** Starts both timers, so the first fetch waits a full interval. Game thread. */
+	void Start(double NowSeconds);
+	/** Counts the next fetch from NowSeconds, e.g. after the user fetched by hand. Game thread. */
+	void ResetTimer(double NowSeconds) { LastFetchSeconds = NowSeconds; }
+
+	/**
+	 * Whether a fetch is due at NowSeconds with the intervals from Settings, as stretched by PollScheduler, and
+	 * whether it should fetch every remote. Restarts the timers when it returns true. Game thread.
+	 */
+	bool ConsumeDueFetch(double NowSeconds, const USafeSaveSettings& Settings, const FSafeSavePollScheduler& PollScheduler, bool& bOutFullFetch);
+
+	/** Fetches the upstream branch of RepoRoot's HEAD if its tip on the remote moved. Worker thread. */
+	FResult FetchUpstreamIfMoved(const FString& RepoRoot) const;
+
+private:
+	const FSafeSaveCommandRunner& Runner;
+	const FSafeSaveGitStatusQuery& GitQuery;
+	double LastFetchSeconds = 0.0;
+	double LastFullFetchSeconds = 0.0;
+};
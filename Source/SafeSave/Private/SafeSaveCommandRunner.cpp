@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveCommandRunner.h"
+
+#include "SafeSaveSettings.h"
+#include "SafeSaveStats.h"
+
+FSafeSaveProcess::FLimits FSafeSaveCommandRunner::GetProcessLimits(bool bRemoteCommand) const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+
+	FSafeSaveProcess::FLimits Limits;
+	Limits.TimeoutSeconds = bRemoteCommand
+		? (Settings ? FMath::Max(10.0, (double)Settings->RemoteCommandTimeoutSeconds) : 300.0)
+		: (Settings ? FMath::Max(5.0, (double)Settings->StatusQueryTimeoutSeconds) : 30.0);
+	Limits.CancelFlag = &bCancelled;
+	return Limits;
+}
+
+bool FSafeSaveCommandRunner::RunGit(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, bool bRemoteCommand) const
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_RunProcess, FSafeSaveCommandRunner::RunGit);
+
+	return FSafeSaveProcess::RunAndCapture(GetGitExecutable(), Args, WorkingDir, OutStdOut, OutStdErr, OutExitCode, GetProcessLimits(bRemoteCommand));
+}
+
+bool FSafeSaveCommandRunner::RunGitStreaming(const FString& Args, const FString& WorkingDir, FSafeSaveProcess::FOnOutput OnStdOut, FString& OutStdErr, int32& OutExitCode) const
+{
+	return FSafeSaveProcess::Run(GetGitExecutable(), Args, WorkingDir, OnStdOut, OutStdErr, OutExitCode, GetProcessLimits(false));
+}
+
+bool FSafeSaveCommandRunner::RunPlastic(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, bool bRemoteCommand) const
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_RunProcess, FSafeSaveCommandRunner::RunPlastic);
+
+	return FSafeSaveProcess::RunAndCapture(GetPlasticExecutable(), Args, WorkingDir, OutStdOut, OutStdErr, OutExitCode, GetProcessLimits(bRemoteCommand));
+}
+
+FString FSafeSaveCommandRunner::GetGitExecutable()
+{
+#if PLATFORM_WINDOWS
+	return TEXT("git.exe");
+#else
+	return TEXT("git");
+#endif
+}
+
+FString FSafeSaveCommandRunner::GetPlasticExecutable()
+{
+#if PLATFORM_WINDOWS
+	return TEXT("cm.exe");
+#else
+	return TEXT("cm");
+#endif
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveProcess.h"
+
+/**
+ * Runs git and cm for the status service and its queries with the timeouts from the settings. Cancel kills
+ * whatever is running and makes later calls fail fast, so shutdown never waits out a slow remote. Any thread.
+ */
+class FSafeSaveCommandRunner
+{
+public:
+	/** Timeout from settings (status query or remote command) plus the cancellation flag. */
+	FSafeSaveProcess::FLimits GetProcessLimits(bool bRemoteCommand) const;
+
+	bool RunGit(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, bool bRemoteCommand = false) const;
+	/** Like RunGit, but hands stdout to OnStdOut as it is read instead of collecting it into a string. */
+	bool RunGitStreaming(const FString& Args, const FString& WorkingDir, FSafeSaveProcess::FOnOutput OnStdOut, FString& OutStdErr, int32& OutExitCode) const;
+	bool RunPlastic(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, bool bRemoteCommand = false) const;
+
+	static FString GetGitExecutable();
+	static FString GetPlasticExecutable();
+
+	/** Set on shutdown so a running git or cm is killed instead of being waited out. */
+	void Cancel() { bCancelled = true; }
+	bool IsCancelled() const { return bCancelled.Load(); }
+
+private:
+	TAtomic<bool> bCancelled = false;
+};
@@ -1,22 +1,271 @@
 #include "SafeSaveDemo.h"
+#include "SafeSaveGitStatusParser.h"
+#include "SafeSaveModule.h"
+#include "SafeSavePlasticStatusQuery.h"
+#include "SafeSaveSettings.h"
+#include "SafeSaveStatusService.h"
 #include "Engine/World.h"
 #include "Engine/StaticMeshActor.h"
 #include "Editor/UnrealEdEngine.h"
 #include "UnrealEdGlobals.h"
 #include "FileHelpers.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+TArray<IConsoleObject*> FSafeSaveDemo::ConsoleObjects;
+
+namespace
+{
+	struct FBenchResult
+	{
+		FString Benchmark;
+		FString Variant;
+		int32 Size = 0;
+		int32 Iterations = 0;
+		double MinMs = 0.0;
+		double AvgMs = 0.0;
+		double MaxMs = 0.0;
+		/** Items per second for Size items per iteration. */
+		double ItemsPerSecond = 0.0;
+	};
+
+	template <typename FuncType>
+	FBenchResult Measure(const FString& Benchmark, const FString& Variant, int32 Size, int32 Iterations, FuncType&& Func)
+	{
+		FBenchResult Result;
+		Result.Benchmark = Benchmark;
+		Result.Variant = Variant;
+		Result.Size = Size;
+		Result.Iterations = FMath::Max(1, Iterations);
+		Result.MinMs = TNumericLimits<double>::Max();
+
+		double TotalMs = 0.0;
+		for (int32 Iteration = 0; Iteration < Result.Iterations; ++Iteration)
+		{
+			const double StartSeconds = FPlatformTime::Seconds();
+			Func();
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+			TotalMs += ElapsedMs;
+			Result.MinMs = FMath::Min(Result.MinMs, ElapsedMs);
+			Result.MaxMs = FMath::Max(Result.MaxMs, ElapsedMs);
+		}
+
+		Result.AvgMs = TotalMs / Result.Iterations;
+		Result.ItemsPerSecond = Result.AvgMs > 0.0 ? Size / (Result.AvgMs / 1000.0) : 0.0;
+
+		UE_LOG(LogTemp, Display, TEXT("[SafeSave.Bench] %s/%s size=%d: avg %.3f ms (min %.3f, max %.3f) over %d runs, %.0f items/s"),
+			*Result.Benchmark, *Result.Variant, Result.Size, Result.AvgMs, Result.MinMs, Result.MaxMs, Result.Iterations, Result.ItemsPerSecond);
+		return Result;
+	}
+
+	/** Appends to one CSV per project so runs from different plugin versions can be compared side by side. */
+	void WriteResults(const TArray<FBenchResult>& Results)
+	{
+		if (Results.Num() == 0)
+		{
+			return;
+		}
+
+		const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("SafeSave/Bench/SafeSaveBench.csv");
+		FString PluginVersion = TEXT("unknown");
+		if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("SafeSave")))
+		{
+			PluginVersion = Plugin->GetDescriptor().VersionName;
+		}
+
+		FString Csv;
+		if (!FPaths::FileExists(CsvPath))
+		{
+			Csv += TEXT("TimestampUtc,PluginVersion,Platform,Benchmark,Variant,Size,Iterations,MinMs,AvgMs,MaxMs,ItemsPerSecond\n");
+		}
+
+		const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+		for (const FBenchResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%s,%s,%s,%d,%d,%.4f,%.4f,%.4f,%.0f\n"),
+				*Timestamp, *PluginVersion, ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()),
+				*Result.Benchmark, *Result.Variant, Result.Size, Result.Iterations,
+				Result.MinMs, Result.AvgMs, Result.MaxMs, Result.ItemsPerSecond);
+		}
+
+		if (FFileHelper::SaveStringToFile(Csv, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[SafeSave.Bench] Wrote %d results to %s"), Results.Num(), *CsvPath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SafeSave.Bench] Could not write %s"), *CsvPath);
+		}
+	}
+
+	TArray<int32> ParseSizes(const TArray<FString>& Args, const TArray<int32>& Defaults)
+	{
+		TArray<int32> Sizes;
+		for (const FString& Arg : Args)
+		{
+			const int32 Size = FCString::Atoi(*Arg);
+			if (Size > 0)
+			{
+				Sizes.Add(Size);
+			}
+		}
+		return Sizes.Num() > 0 ? Sizes : Defaults;
+	}
+
+	void AppendUtf8(TArray<uint8>& Out, const FString& Text)
+	{
+		const FTCHARToUTF8 Converted(*Text);
+		Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	/** Synthetic `git status --porcelain=v2 -b -z` output with a realistic mix of modified, staged, renamed, untracked and conflicted entries. */
+	TArray<uint8> MakeGitStatusOutput(int32 NumEntries)
+	{
+		const FString Hash = TEXT("0123456789abcdef0123456789abcdef01234567");
+		TArray<uint8> Out;
+		Out.Reserve(NumEntries * 160);
+
+		const TCHAR* Headers[] =
+		{
+			TEXT("# branch.oid 0123456789abcdef0123456789abcdef01234567"),
+			TEXT("# branch.head main"),
+			TEXT("# branch.upstream origin/main"),
+			TEXT("# branch.ab +3 -1"),
+		};
+		for (const TCHAR* Header : Headers)
+		{
+			AppendUtf8(Out, Header);
+			Out.Add(0);
+		}
+
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			const int32 Folder = Index / 100;
+			switch (Index % 10)
+			{
+			case 6:
+				AppendUtf8(Out, FString::Printf(TEXT("1 M. N... 100644 100644 100644 %s %s Content/Bench/Folder_%d/Staged Asset_%d.uasset"), *Hash, *Hash, Folder, Index));
+				break;
+			case 7:
+				AppendUtf8(Out, FString::Printf(TEXT("2 R. N... 100644 100644 100644 %s %s R100 Content/Bench/Folder_%d/Renamed_%d.uasset"), *Hash, *Hash, Folder, Index));
+				Out.Add(0);
+				AppendUtf8(Out, FString::Printf(TEXT("Content/Bench/Folder_%d/Old_%d.uasset"), Folder, Index));
+				break;
+			case 8:
+				AppendUtf8(Out, FString::Printf(TEXT("? Content/Bench/Folder_%d/New_%d.uasset"), Folder, Index));
+				break;
+			case 9:
+				AppendUtf8(Out, FString::Printf(TEXT("u UU N... 100644 100644 100644 100644 %s %s %s Content/Bench/Folder_%d/Conflict_%d.umap"), *Hash, *Hash, *Hash, Folder, Index));
+				break;
+			default:
+				AppendUtf8(Out, FString::Printf(TEXT("1 .M N... 100644 100644 100644 %s %s Content/Bench/Folder_%d/Asset_%d.uasset"), *Hash, *Hash, Folder, Index));
+				break;
+			}
+			Out.Add(0);
+		}
+
+		return Out;
+	}
+
+	/** Synthetic `cm status --machinereadable` output using the separators SafeSave passes to cm. */
+	FString MakePlasticStatusOutput(const FString& RootDir, int32 NumEntries)
+	{
+		FString Out;
+		Out.Reserve(NumEntries * 120);
+
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			const TCHAR* Code = TEXT("CH");
+			const TCHAR* MergeInfo = TEXT("NO_MERGES");
+			switch (Index % 10)
+			{
+			case 7: Code = TEXT("CO+CH"); break;
+			case 8: Code = TEXT("PR"); break;
+			case 9: MergeInfo = TEXT("MERGE_CONFLICT"); break;
+			default: break;
+			}
+
+			Out += FString::Printf(TEXT("@@SAFE@@%s|%sContent/Bench/Folder_%d/Asset_%d.uasset|False|%s##SAFE##\n"), Code, *RootDir, Index / 100, Index, MergeInfo);
+		}
+
+		return Out;
+	}
+
+	/** Temporarily overrides settings that would skew a benchmark (toasts, tracking mode) and restores them afterwards. */
+	struct FScopedBenchSettings
+	{
+		FScopedBenchSettings()
+			: Settings(GetMutableDefault<USafeSaveSettings>())
+		{
+			bToastOnStatusChange = Settings->bToastOnStatusChange;
+			bEventDrivenDirtyTracking = Settings->bEventDrivenDirtyTracking;
+			Settings->bToastOnStatusChange = false;
+		}
+
+		~FScopedBenchSettings()
+		{
+			Settings->bToastOnStatusChange = bToastOnStatusChange;
+			Settings->bEventDrivenDirtyTracking = bEventDrivenDirtyTracking;
+		}
+
+		USafeSaveSettings* Settings;
+		bool bToastOnStatusChange;
+		bool bEventDrivenDirtyTracking;
+	};
+}
 
 void FSafeSaveDemo::RegisterCommands()
 {
 	// Registers console command: 'SafeSave.StressTest'
 	if (GUnrealEd)
 	{
-		IConsoleManager::Get().RegisterConsoleCommand(
+		ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(
 			TEXT("SafeSave.StressTest"),
 			TEXT("Generates 1000 dirty actors to test SafeSave performance."),
 			FConsoleCommandDelegate::CreateStatic(&FSafeSaveDemo::GenerateStressScene),
 			ECVF_Default
-		);
+		));
 	}
+
+	ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SafeSave.Bench.UnsavedState"),
+		TEXT("Measures UpdateUnsavedState with N dirty packages, event-driven and polling. Usage: SafeSave.Bench.UnsavedState [N...] (default 1000 10000 100000)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FSafeSaveDemo::RunUnsavedStateBenchmark),
+		ECVF_Default
+	));
+	ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SafeSave.Bench.Parse"),
+		TEXT("Measures Git and Plastic status parse throughput on synthetic output. Usage: SafeSave.Bench.Parse [Entries...] (default 100000)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FSafeSaveDemo::RunParseBenchmark),
+		ECVF_Default
+	));
+	ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SafeSave.Bench.Refresh"),
+		TEXT("Measures end-to-end status refresh latency per provider, cold and with cached detection. Blocks the editor while running. Usage: SafeSave.Bench.Refresh [Iterations] (default 10)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FSafeSaveDemo::RunRefreshBenchmark),
+		ECVF_Default
+	));
+	ConsoleObjects.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("SafeSave.Bench.All"),
+		TEXT("Runs every SafeSave.Bench.* benchmark with its default sizes."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FSafeSaveDemo::RunAllBenchmarks),
+		ECVF_Default
+	));
+}
+
+void FSafeSaveDemo::UnregisterCommands()
+{
+	for (IConsoleObject* ConsoleObject : ConsoleObjects)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleObject);
+	}
+	ConsoleObjects.Reset();
 }
 
 void FSafeSaveDemo::GenerateStressScene()
@@ -65,4 +314,187 @@ void FSafeSaveDemo::GenerateStressScene()
 	GEditor->EndTransaction();
 
 	UE_LOG(LogTemp, Warning, TEXT("[SafeSave] Stress Scene Generated. 1000 Actors Dirty. Check UI for Lag."));
+}
+
+void FSafeSaveDemo::RunUnsavedStateBenchmark(const TArray<FString>& Args)
+{
+	TSharedPtr<FSafeSaveStatusService> StatusService = FSafeSaveModule::Get().GetStatusService();
+	if (!StatusService.IsValid())
+	{
+		return;
+	}
+
+	TArray<int32> Sizes = ParseSizes(Args, { 1000, 10000, 100000 });
+	Sizes.Sort();
+
+	FScopedBenchSettings ScopedSettings;
+	TArray<FBenchResult> Results;
+	TArray<UPackage*> Packages;
+	constexpr int32 Iterations = 20;
+
+	for (const int32 Size : Sizes)
+	{
+		// Packages are kept between sizes; only the difference is created and dirtied.
+		const int32 FirstNew = Packages.Num();
+		for (int32 Index = FirstNew; Index < Size; ++Index)
+		{
+			Packages.Add(CreatePackage(*FString::Printf(TEXT("/Game/__SafeSaveBench/Pkg_%d"), Index)));
+		}
+
+		ScopedSettings.Settings->bEventDrivenDirtyTracking = true;
+		StatusService->UpdateUnsavedState();
+
+		Results.Add(Measure(TEXT("UnsavedState"), TEXT("MarkDirty"), Size - FirstNew, 1, [&Packages, FirstNew]()
+		{
+			for (int32 Index = FirstNew; Index < Packages.Num(); ++Index)
+			{
+				Packages[Index]->SetDirtyFlag(true);
+			}
+		}));
+
+		StatusService->UpdateUnsavedState();
+		Results.Add(Measure(TEXT("UnsavedState"), TEXT("EventDriven"), Size, Iterations, [&StatusService]()
+		{
+			StatusService->UpdateUnsavedState();
+		}));
+
+		ScopedSettings.Settings->bEventDrivenDirtyTracking = false;
+		StatusService->UpdateUnsavedState();
+		Results.Add(Measure(TEXT("UnsavedState"), TEXT("Polling"), Size, Iterations, [&StatusService]()
+		{
+			StatusService->UpdateUnsavedState();
+		}));
+	}
+
+	for (UPackage* Package : Packages)
+	{
+		Package->SetDirtyFlag(false);
+		Package->MarkAsGarbage();
+	}
+	Packages.Reset();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	ScopedSettings.Settings->bEventDrivenDirtyTracking = ScopedSettings.bEventDrivenDirtyTracking;
+	StatusService->UpdateUnsavedState();
+	WriteResults(Results);
+}
+
+void FSafeSaveDemo::RunParseBenchmark(const TArray<FString>& Args)
+{
+	const TArray<int32> Sizes = ParseSizes(Args, { 100000 });
+	const FString RootDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	constexpr int32 Iterations = 10;
+	TArray<FBenchResult> Results;
+
+	for (const int32 Size : Sizes)
+	{
+		const TArray<uint8> GitOutput = MakeGitStatusOutput(Size);
+		const FString PlasticOutput = MakePlasticStatusOutput(RootDir, Size);
+
+		Results.Add(Measure(TEXT("Parse"), TEXT("Git"), Size, Iterations, [&GitOutput]()
+		{
+			FSafeSaveSourceControlStatus Status;
+			FSafeSaveGitStatusParser::Parse(GitOutput, Status);
+		}));
+
+		Results.Add(Measure(TEXT("Parse"), TEXT("GitStreamed64K"), Size, Iterations, [&GitOutput]()
+		{
+			// Same data fed in pipe-sized chunks, so records are split across Feed calls.
+			FSafeSaveSourceControlStatus Status;
+			FSafeSaveGitStatusParser Parser(Status);
+			for (int32 Offset = 0; Offset < GitOutput.Num(); Offset += 65536)
+			{
+				Parser.Feed(GitOutput.GetData() + Offset, FMath::Min(65536, GitOutput.Num() - Offset));
+			}
+			Parser.Finish();
+		}));
+
+		Results.Add(Measure(TEXT("Parse"), TEXT("GitWithIndex"), Size, Iterations, [&GitOutput, &RootDir]()
+		{
+			FSafeSaveSourceControlStatus Status;
+			FSafeSaveFileStatusIndex::FBuilder IndexBuilder(RootDir);
+			FSafeSaveGitStatusParser Parser(Status);
+			Parser.SetFileIndexBuilder(&IndexBuilder);
+			Parser.Feed(GitOutput.GetData(), GitOutput.Num());
+			Parser.Finish();
+			IndexBuilder.Build();
+		}));
+
+		Results.Add(Measure(TEXT("Parse"), TEXT("Plastic"), Size, Iterations, [&PlasticOutput]()
+		{
+			FSafeSaveSourceControlStatus Status;
+			FSafeSavePlasticStatusQuery::ParseStatusOutput(PlasticOutput, Status, nullptr);
+		}));
+
+		Results.Add(Measure(TEXT("Parse"), TEXT("PlasticWithIndex"), Size, Iterations, [&PlasticOutput, &RootDir]()
+		{
+			FSafeSaveSourceControlStatus Status;
+			FSafeSaveFileStatusIndex::FBuilder IndexBuilder(RootDir);
+			FSafeSavePlasticStatusQuery::ParseStatusOutput(PlasticOutput, Status, &IndexBuilder);
+			IndexBuilder.Build();
+		}));
+	}
+
+	WriteResults(Results);
+}
+
+void FSafeSaveDemo::RunRefreshBenchmark(const TArray<FString>& Args)
+{
+	TSharedPtr<FSafeSaveStatusService> StatusService = FSafeSaveModule::Get().GetStatusService();
+	if (!StatusService.IsValid())
+	{
+		return;
+	}
+
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	TArray<FBenchResult> Results;
+
+	const TPair<ESafeSaveSourceControlProvider, const TCHAR*> Providers[] =
+	{
+		{ ESafeSaveSourceControlProvider::Git, TEXT("Git") },
+		{ ESafeSaveSourceControlProvider::Plastic, TEXT("Plastic") },
+	};
+
+	for (const TPair<ESafeSaveSourceControlProvider, const TCHAR*>& Provider : Providers)
+	{
+		FSafeSaveSourceControlStatus Status;
+		FString Error;
+		StatusService->InvalidateDetectionCache();
+		if (!StatusService->QueryProviderStatus(ProjectDir, Provider.Key, Status, Error) || !Status.bRepo)
+		{
+			UE_LOG(LogTemp, Display, TEXT("[SafeSave.Bench] Refresh/%s skipped: %s"), Provider.Value, Error.IsEmpty() ? TEXT("no repository") : *Error);
+			continue;
+		}
+
+		const int32 Changes = Status.Staged + Status.Unstaged + Status.Untracked;
+
+		Results.Add(Measure(TEXT("Refresh"), FString::Printf(TEXT("%sCold"), Provider.Value), Changes, Iterations, [&StatusService, &Provider, &ProjectDir]()
+		{
+			FSafeSaveSourceControlStatus IterationStatus;
+			FString IterationError;
+			StatusService->InvalidateDetectionCache();
+			StatusService->QueryProviderStatus(ProjectDir, Provider.Key, IterationStatus, IterationError);
+		}));
+
+		StatusService->QueryProviderStatus(ProjectDir, Provider.Key, Status, Error);
+		Results.Add(Measure(TEXT("Refresh"), FString::Printf(TEXT("%sWarm"), Provider.Value), Changes, Iterations, [&StatusService, &Provider, &ProjectDir]()
+		{
+			FSafeSaveSourceControlStatus IterationStatus;
+			FString IterationError;
+			StatusService->QueryProviderStatus(ProjectDir, Provider.Key, IterationStatus, IterationError);
+		}));
+	}
+
+	// Leave detection to the regular refresh rather than whichever provider was benchmarked last.
+	StatusService->InvalidateDetectionCache();
+	StatusService->RequestSourceControlStatusUpdate();
+	WriteResults(Results);
+}
+
+void FSafeSaveDemo::RunAllBenchmarks(const TArray<FString>& Args)
+{
+	RunUnsavedStateBenchmark({});
+	RunParseBenchmark({});
+	RunRefreshBenchmark({});
 }
@@ -5,8 +5,17 @@ class FSafeSaveDemo
 {
 public:
 	static void RegisterCommands();
+	static void UnregisterCommands();
 
 private:
 	// Generates 1,000 actors in a spiral and dirties them to test UI performance
 	static void GenerateStressScene();
+
+	// SafeSave.Bench.* - each appends its results to Saved/SafeSave/Bench/SafeSaveBench.csv
+	static void RunUnsavedStateBenchmark(const TArray<FString>& Args);
+	static void RunParseBenchmark(const TArray<FString>& Args);
+	static void RunRefreshBenchmark(const TArray<FString>& Args);
+	static void RunAllBenchmarks(const TArray<FString>& Args);
+
+	static TArray<IConsoleObject*> ConsoleObjects;
 };
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveDetectionCache.h"
+
+#include "Misc/ScopeLock.h"
+
+bool FSafeSaveDetectionCache::Get(ESafeSaveSourceControlProvider Provider, const FString& ProjectDir, FDetection& OutDetection) const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Detection.Provider != Provider || Detection.RepoRoot.IsEmpty() || Detection.ProjectDir != ProjectDir)
+	{
+		return false;
+	}
+
+	OutDetection = Detection;
+	return true;
+}
+
+ESafeSaveSourceControlProvider FSafeSaveDetectionCache::GetProvider(const FString& ProjectDir) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Detection.ProjectDir == ProjectDir ? Detection.Provider : ESafeSaveSourceControlProvider::None;
+}
+
+FString FSafeSaveDetectionCache::GetRepoRoot(const FString& ProjectDir) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Detection.ProjectDir == ProjectDir ? Detection.RepoRoot : FString();
+}
+
+void FSafeSaveDetectionCache::Store(const FDetection& InDetection)
+{
+	FScopeLock ScopeLock(&Lock);
+	Detection = InDetection;
+}
+
+void FSafeSaveDetectionCache::Invalidate()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		Detection = FDetection();
+	}
+
+	if (OnInvalidated)
+	{
+		OnInvalidated();
+	}
+}
+
+FSafeSaveFileStatusIndexPtr FSafeSaveDetectionCache::ResolveFileIndex(const FString& RepoRoot, const FSafeSaveFileStatusIndex::FBuilder& Builder)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FileIndex.IsValid() && FileIndexRepoRoot == RepoRoot && FileIndex->GetChecksum() == Builder.GetChecksum())
+		{
+			// Same changed set as the previous poll; keep the published index instead of resolving every path again.
+			return FileIndex;
+		}
+	}
+
+	FSafeSaveFileStatusIndexPtr Index = Builder.Build();
+
+	FScopeLock ScopeLock(&Lock);
+	FileIndexRepoRoot = RepoRoot;
+	FileIndex = Index;
+	return Index;
+}
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SafeSaveFileStatusIndex.h"
+#include "SafeSaveSourceControlStatus.h"
+
+/**
+ * Provider and repository the project was found in, resolved once and reused across polls until a query
+ * fails, plus the last per-file index built for it. Shared by the Git and Plastic status queries; any thread.
+ */
+class FSafeSaveDetectionCache
+{
+public:
+	struct FDetection
+	{
+		ESafeSaveSourceControlProvider Provider = ESafeSaveSourceControlProvider::None;
+		FString ProjectDir;
+		FString RepoRoot;
+		FString WorkspaceName;
+	};
+
+	/** Whether Provider was detected for ProjectDir; a cache miss means detecting it again. */
+	bool Get(ESafeSaveSourceControlProvider Provider, const FString& ProjectDir, FDetection& OutDetection) const;
+	ESafeSaveSourceControlProvider GetProvider(const FString& ProjectDir) const;
+	FString GetRepoRoot(const FString& ProjectDir) const;
+	void Store(const FDetection& Detection);
+
+	/**
+	 * Forgets the detection so the next query detects the provider and root again, then runs the callback set
+	 * with SetOnInvalidated (outside the lock) so caches derived from the detection are dropped with it.
+	 */
+	void Invalidate();
+	/** Set once, before the first query. */
+	void SetOnInvalidated(TFunction<void()>&& InOnInvalidated) { OnInvalidated = MoveTemp(InOnInvalidated); }
+
+	/** Builds the index, or returns the last one while the changed set of RepoRoot stays the same. */
+	FSafeSaveFileStatusIndexPtr ResolveFileIndex(const FString& RepoRoot, const FSafeSaveFileStatusIndex::FBuilder& Builder);
+
+private:
+	FDetection Detection;
+	FString FileIndexRepoRoot;
+	FSafeSaveFileStatusIndexPtr FileIndex;
+	TFunction<void()> OnInvalidated;
+	mutable FCriticalSection Lock;
+};
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveDirtyPackageTracker.h"
+
+#include "SafeSavePackageFilter.h"
+#include "SafeSaveStats.h"
+
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FSafeSaveDirtyPackageTracker::FSafeSaveDirtyPackageTracker(const TSharedRef<const FSafeSavePackageFilter>& InFilter)
+	: Filter(InFilter)
+{
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FSafeSaveDirtyPackageTracker::HandlePackageMarkedDirty);
+	PackageDirtyStateChangedHandle = UPackage::PackageDirtyStateChangedEvent.AddRaw(this, &FSafeSaveDirtyPackageTracker::HandlePackageDirtyStateChanged);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FSafeSaveDirtyPackageTracker::HandlePackageSaved);
+	PackageDeletedHandle = FEditorDelegates::OnPackageDeleted.AddRaw(this, &FSafeSaveDirtyPackageTracker::HandlePackageDeleted);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FSafeSaveDirtyPackageTracker::HandlePostGarbageCollect);
+
+	Reconcile();
+}
+
+FSafeSaveDirtyPackageTracker::~FSafeSaveDirtyPackageTracker()
+{
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+	UPackage::PackageDirtyStateChangedEvent.Remove(PackageDirtyStateChangedHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FEditorDelegates::OnPackageDeleted.Remove(PackageDeletedHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+void FSafeSaveDirtyPackageTracker::Reconcile()
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_ReconcileDirtyPackages, FSafeSaveDirtyPackageTracker::Reconcile);
+
+	TArray<UPackage*> Packages;
+	FEditorFileUtils::GetDirtyPackages(Packages);
+
+	DirtyPackages.Reset();
+	DirtyPackages.Reserve(Packages.Num());
+	for (const UPackage* Package : Packages)
+	{
+		if (Filter->ShouldCount(Package))
+		{
+			DirtyPackages.Add(FObjectKey(Package), Package->GetName());
+		}
+	}
+
+	RefreshSampleIfMissing();
+}
+
+void FSafeSaveDirtyPackageTracker::SetFilter(const TSharedRef<const FSafeSavePackageFilter>& InFilter)
+{
+	Filter = InFilter;
+	Reconcile();
+}
+
+void FSafeSaveDirtyPackageTracker::HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	AddPackage(Package);
+}
+
+void FSafeSaveDirtyPackageTracker::HandlePackageDirtyStateChanged(UPackage* Package)
+{
+	if (Package && Package->IsDirty())
+	{
+		AddPackage(Package);
+	}
+	else
+	{
+		RemovePackage(Package);
+	}
+}
+
+void FSafeSaveDirtyPackageTracker::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (Package && !Package->IsDirty())
+	{
+		RemovePackage(Package);
+	}
+}
+
+void FSafeSaveDirtyPackageTracker::HandlePackageDeleted(UPackage* Package)
+{
+	RemovePackage(Package);
+}
+
+void FSafeSaveDirtyPackageTracker::HandlePostGarbageCollect()
+{
+	for (auto It = DirtyPackages.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	RefreshSampleIfMissing();
+}
+
+void FSafeSaveDirtyPackageTracker::AddPackage(const UPackage* Package)
+{
+	if (!ShouldTrackPackage(Package))
+	{
+		return;
+	}
+
+	const FObjectKey Key(Package);
+	if (!DirtyPackages.Contains(Key))
+	{
+		DirtyPackages.Add(Key, Package->GetName());
+	}
+
+	if (SamplePackageName.IsEmpty())
+	{
+		SamplePackageKey = Key;
+		SamplePackageName = DirtyPackages.FindChecked(Key);
+	}
+}
+
+void FSafeSaveDirtyPackageTracker::RemovePackage(const UPackage* Package)
+{
+	if (!Package)
+	{
+		return;
+	}
+
+	const FObjectKey Key(Package);
+	if (DirtyPackages.Remove(Key) > 0 && Key == SamplePackageKey)
+	{
+		SamplePackageKey = FObjectKey();
+		SamplePackageName.Reset();
+		RefreshSampleIfMissing();
+	}
+}
+
+void FSafeSaveDirtyPackageTracker::RefreshSampleIfMissing()
+{
+	if (!SamplePackageName.IsEmpty() && DirtyPackages.Contains(SamplePackageKey))
+	{
+		return;
+	}
+
+	SamplePackageKey = FObjectKey();
+	SamplePackageName.Reset();
+
+	auto It = DirtyPackages.CreateConstIterator();
+	if (It)
+	{
+		SamplePackageKey = It.Key();
+		SamplePackageName = It.Value();
+	}
+}
+
+bool FSafeSaveDirtyPackageTracker::ShouldTrackPackage(const UPackage* Package) const
+{
+	// Mirrors the packages FEditorFileUtils::GetDirtyPackages would report, minus the filtered ones.
+	return Package
+		&& Package->IsDirty()
+		&& Package != GetTransientPackage()
+		&& !Package->HasAnyFlags(RF_Transient)
+		&& !Package->HasAnyPackageFlags(PKG_CompiledIn)
+		&& Filter->ShouldCount(Package);
+}
@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UPackage;
+class FObjectPostSaveContext;
+class FSafeSavePackageFilter;
+
+/**
+ * Keeps an incremental set of dirty packages by listening to package dirty/save/delete and GC events,
+ * so the unsaved count and sample package can be read in O(1) without walking every loaded package.
+ * A full sweep (Reconcile) is only needed occasionally to correct drift. Packages the filter rejects
+ * (transient mount points, generated instance packages) are never tracked.
+ */
+class FSafeSaveDirtyPackageTracker
+{
+public:
+	explicit FSafeSaveDirtyPackageTracker(const TSharedRef<const FSafeSavePackageFilter>& InFilter);
+	~FSafeSaveDirtyPackageTracker();
+
+	/** Rebuilds the tracked set from FEditorFileUtils::GetDirtyPackages. */
+	void Reconcile();
+
+	/** Swaps the filter and reconciles, so packages it now rejects (or accepts) are updated immediately. */
+	void SetFilter(const TSharedRef<const FSafeSavePackageFilter>& InFilter);
+
+	int32 GetDirtyPackageCount() const { return DirtyPackages.Num(); }
+	const FString& GetSamplePackageName() const { return SamplePackageName; }
+
+private:
+	void HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void HandlePackageDirtyStateChanged(UPackage* Package);
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	void HandlePackageDeleted(UPackage* Package);
+	void HandlePostGarbageCollect();
+
+	void AddPackage(const UPackage* Package);
+	void RemovePackage(const UPackage* Package);
+	void RefreshSampleIfMissing();
+
+	bool ShouldTrackPackage(const UPackage* Package) const;
+
+	TSharedRef<const FSafeSavePackageFilter> Filter;
+	TMap<FObjectKey, FString> DirtyPackages;
+	FObjectKey SamplePackageKey;
+	FString SamplePackageName;
+
+	FDelegateHandle PackageMarkedDirtyHandle;
+	FDelegateHandle PackageDirtyStateChangedHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle PackageDeletedHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
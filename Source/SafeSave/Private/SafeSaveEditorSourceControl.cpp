@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveEditorSourceControl.h"
+
+#include "SafeSaveGitRepository.h"
+#include "SafeSaveSettings.h"
+#include "SafeSaveStats.h"
+
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "ISourceControlState.h"
+#include "Misc/Paths.h"
+
+FString FSafeSaveEditorSourceControl::GetAvailableProviderName()
+{
+	ISourceControlModule& SourceControlModule = ISourceControlModule::Get();
+	if (!SourceControlModule.IsEnabled())
+	{
+		return FString();
+	}
+
+	ISourceControlProvider& Provider = SourceControlModule.GetProvider();
+	return Provider.IsAvailable() ? Provider.GetName().ToString() : FString();
+}
+
+ESafeSaveSourceControlProvider FSafeSaveEditorSourceControl::ToCommandLineProvider(const FString& ProviderName)
+{
+	const FString Lower = ProviderName.ToLower();
+	if (Lower.Contains(TEXT("plastic")) || Lower.Contains(TEXT("unity")))
+	{
+		return ESafeSaveSourceControlProvider::Plastic;
+	}
+	if (Lower.Contains(TEXT("git")))
+	{
+		return ESafeSaveSourceControlProvider::Git;
+	}
+	return ESafeSaveSourceControlProvider::None;
+}
+
+TArray<FString> FSafeSaveEditorSourceControl::GetUpdatePaths(const USafeSaveSettings* Settings, const FString& ProjectDir)
+{
+	TArray<FString> Paths;
+	if (Settings)
+	{
+		for (const FString& ScopePath : Settings->StatusScopePaths)
+		{
+			const FString Trimmed = ScopePath.TrimStartAndEnd();
+			const FString FullPath = Trimmed.IsEmpty() ? FString() : (FPaths::IsRelative(Trimmed) ? FPaths::ConvertRelativePathToFull(ProjectDir, Trimmed) : Trimmed);
+			if (!FullPath.IsEmpty() && FPaths::DirectoryExists(FullPath))
+			{
+				Paths.Add(FullPath / TEXT(""));
+			}
+		}
+	}
+
+	if (Paths.Num() == 0)
+	{
+		Paths.Add(FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()));
+	}
+	return Paths;
+}
+
+FString FSafeSaveEditorSourceControl::FindRoot(const FString& ProviderName, const FString& ProjectDir)
+{
+	FString Root;
+	if (ToCommandLineProvider(ProviderName) == ESafeSaveSourceControlProvider::Git && FSafeSaveGitRepository::FindRepositoryRoot(ProjectDir, Root))
+	{
+		return Root;
+	}
+
+	const TMap<ISourceControlProvider::EStatus, FString> ProviderStatus = ISourceControlModule::Get().GetProvider().GetStatus();
+	if (const FString* WorkspacePath = ProviderStatus.Find(ISourceControlProvider::EStatus::WorkspacePath))
+	{
+		Root = FPaths::ConvertRelativePathToFull(*WorkspacePath);
+		FPaths::NormalizeDirectoryName(Root);
+		if (!Root.IsEmpty())
+		{
+			return Root;
+		}
+	}
+
+	Root = ProjectDir;
+	FPaths::NormalizeDirectoryName(Root);
+	return Root;
+}
+
+void FSafeSaveEditorSourceControl::BuildStatusFromCache(const FString& ProviderName, const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FSafeSaveFileStatusIndex::FBuilder& IndexBuilder, FSafeSaveLockIndex& OutLocks)
+{
+	ISourceControlProvider& Provider = ISourceControlModule::Get().GetProvider();
+
+	OutStatus = FSafeSaveSourceControlStatus();
+	OutStatus.Provider = ToCommandLineProvider(ProviderName);
+	OutStatus.EditorProviderName = ProviderName;
+	OutStatus.bClientAvailable = true;
+	OutStatus.bRepo = true;
+	OutStatus.RepoRoot = FindRoot(ProviderName, ProjectDir);
+	OutStatus.ScanMode = FString::Printf(TEXT("editor source control (%s)"), *ProviderName);
+
+	const TMap<ISourceControlProvider::EStatus, FString> ProviderStatus = Provider.GetStatus();
+	if (const FString* Branch = ProviderStatus.Find(ISourceControlProvider::EStatus::Branch))
+	{
+		OutStatus.Branch = *Branch;
+	}
+	if (const FString* Workspace = ProviderStatus.Find(ISourceControlProvider::EStatus::Workspace))
+	{
+		OutStatus.WorkspaceName = *Workspace;
+	}
+
+	// Only states worth reporting are collected; an up-to-date, unmodified file contributes nothing.
+	const TArray<FSourceControlStateRef> States = Provider.GetCachedStateByPredicate([](const FSourceControlStateRef& State)
+	{
+		return State->IsConflicted()
+			|| State->IsCheckedOut()
+			|| State->IsAdded()
+			|| State->IsDeleted()
+			|| State->IsModified()
+			|| State->IsCheckedOutOther()
+			|| (State->IsSourceControlled() && !State->IsCurrent())
+			|| (!State->IsSourceControlled() && !State->IsIgnored() && !State->IsUnknown());
+	});
+
+	for (const FSourceControlStateRef& State : States)
+	{
+		const FString& Filename = State->GetFilename();
+
+		FString LockOwner;
+		if (State->IsCheckedOutOther(&LockOwner))
+		{
+			FSafeSaveFileLock Lock;
+			Lock.Owner = MoveTemp(LockOwner);
+			OutLocks.Add(Filename, MoveTemp(Lock));
+		}
+
+		if (State->IsSourceControlled() && !State->IsCurrent())
+		{
+			++OutStatus.Behind;
+		}
+
+		ESafeSaveFileStatus FileStatus = ESafeSaveFileStatus::None;
+		if (State->IsConflicted())
+		{
+			FileStatus = ESafeSaveFileStatus::Conflicted;
+			OutStatus.bHasConflicts = true;
+			++OutStatus.Unstaged;
+		}
+		else if (State->IsCheckedOut() || State->IsAdded() || State->IsDeleted() || State->IsModified())
+		{
+			FileStatus = ESafeSaveFileStatus::Modified;
+			++OutStatus.Unstaged;
+		}
+		else if (!State->IsSourceControlled() && !State->IsIgnored() && !State->IsUnknown())
+		{
+			FileStatus = ESafeSaveFileStatus::Untracked;
+			++OutStatus.Untracked;
+		}
+
+		if (FileStatus != ESafeSaveFileStatus::None)
+		{
+			IndexBuilder.AddAbsolute(Filename, FileStatus);
+		}
+	}
+
+	FSafeSaveStats::RecordParsedEntries(States.Num());
+}
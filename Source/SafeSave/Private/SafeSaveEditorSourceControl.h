@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveFileStatusIndex.h"
+#include "SafeSaveLockIndex.h"
+#include "SafeSaveSourceControlStatus.h"
+
+class USafeSaveSettings;
+
+/**
+ * Status from the editor's own source control provider (Perforce, Git, Unity Version Control, ...). The provider
+ * keeps a state per file that it refreshes for the content browser anyway; SafeSave summarizes that cache
+ * instead of running its own git or cm, and only asks the provider for an asynchronous FUpdateStatus on the
+ * poll interval. Game thread only, like the provider API.
+ */
+class FSafeSaveEditorSourceControl
+{
+public:
+	/** Name of the editor's provider when it is enabled and available, otherwise empty. */
+	static FString GetAvailableProviderName();
+
+	/** The command line provider matching an editor provider name, so pull/push/update keep working; None for others. */
+	static ESafeSaveSourceControlProvider ToCommandLineProvider(const FString& ProviderName);
+
+	/** Directories the FUpdateStatus covers: the status scope paths that exist, or the project's Content directory. */
+	static TArray<FString> GetUpdatePaths(const USafeSaveSettings* Settings, const FString& ProjectDir);
+
+	/**
+	 * Summarizes the provider's cached file states into OutStatus, adds changed files to IndexBuilder (by
+	 * absolute path) and files checked out or locked by other users to OutLocks.
+	 */
+	static void BuildStatusFromCache(const FString& ProviderName, const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FSafeSaveFileStatusIndex::FBuilder& IndexBuilder, FSafeSaveLockIndex& OutLocks);
+
+	/** Workspace root reported by the provider (repository root for Git), or ProjectDir. */
+	static FString FindRoot(const FString& ProviderName, const FString& ProjectDir);
+};
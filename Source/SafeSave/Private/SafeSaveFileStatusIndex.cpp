@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveFileStatusIndex.h"
+
+#include "SafeSaveStats.h"
+
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	bool IsPackageFile(FAnsiStringView Path)
+	{
+		return Path.EndsWith(".uasset", ESearchCase::IgnoreCase) || Path.EndsWith(".umap", ESearchCase::IgnoreCase);
+	}
+
+	bool IsPackageFile(const FString& Path)
+	{
+		return Path.EndsWith(TEXT(".uasset"), ESearchCase::IgnoreCase) || Path.EndsWith(TEXT(".umap"), ESearchCase::IgnoreCase);
+	}
+}
+
+FSafeSaveFileStatusIndex::FBuilder::FBuilder(const FString& InRepoRoot)
+	: RepoRoot(InRepoRoot)
+{
+}
+
+void FSafeSaveFileStatusIndex::FBuilder::AddRelative(FAnsiStringView RelativePath, ESafeSaveFileStatus Status)
+{
+	Checksum = FCrc::MemCrc32(RelativePath.GetData(), RelativePath.Len(), Checksum);
+	Checksum = FCrc::MemCrc32(&Status, sizeof(Status), Checksum);
+
+	if (IsPackageFile(RelativePath))
+	{
+		const FUTF8ToTCHAR Converted(RelativePath.GetData(), RelativePath.Len());
+		Entries.Emplace(RepoRoot / FString(Converted.Length(), Converted.Get()), Status);
+	}
+}
+
+void FSafeSaveFileStatusIndex::FBuilder::AddAbsolute(const FString& Filename, ESafeSaveFileStatus Status)
+{
+	Checksum = FCrc::StrCrc32(*Filename, Checksum);
+	Checksum = FCrc::MemCrc32(&Status, sizeof(Status), Checksum);
+
+	if (IsPackageFile(Filename))
+	{
+		Entries.Emplace(Filename, Status);
+	}
+}
+
+void FSafeSaveFileStatusIndex::FBuilder::Append(const FBuilder& Other)
+{
+	Checksum = HashCombineFast(Checksum, Other.Checksum);
+	Entries.Append(Other.Entries);
+}
+
+TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> FSafeSaveFileStatusIndex::FBuilder::Build() const
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_BuildFileIndex, FSafeSaveFileStatusIndex::Build);
+
+	TSharedRef<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> Index = MakeShared<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe>();
+	Index->Checksum = Checksum;
+	Index->Entries.Reserve(Entries.Num());
+
+	FString PackageName;
+	for (const TPair<FString, ESafeSaveFileStatus>& Entry : Entries)
+	{
+		// Files outside any mounted content root (other projects in the same repository) have no package name.
+		if (!FPackageName::TryConvertFilenameToLongPackageName(Entry.Key, PackageName) || PackageName.Len() >= NAME_SIZE)
+		{
+			continue;
+		}
+
+		Index->Entries.FindOrAdd(FName(*PackageName)) |= Entry.Value;
+	}
+
+	Index->Entries.Compact();
+	return Index;
+}
+
+TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> FSafeSaveFileStatusIndex::FromEntries(TMap<FName, ESafeSaveFileStatus>&& InEntries, uint32 InChecksum)
+{
+	TSharedRef<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> Index = MakeShared<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe>();
+	Index->Checksum = InChecksum;
+	Index->Entries = MoveTemp(InEntries);
+	return Index;
+}
+
+TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> FSafeSaveFileStatusIndex::Combine(const FSafeSaveFileStatusIndex& A, const FSafeSaveFileStatusIndex& B)
+{
+	TSharedRef<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> Index = MakeShared<FSafeSaveFileStatusIndex, ESPMode::ThreadSafe>();
+	Index->Checksum = HashCombineFast(A.Checksum, B.Checksum);
+	Index->Entries = A.Entries;
+	for (const TPair<FName, ESafeSaveFileStatus>& Entry : B.Entries)
+	{
+		Index->Entries.FindOrAdd(Entry.Key) |= Entry.Value;
+	}
+	return Index;
+}
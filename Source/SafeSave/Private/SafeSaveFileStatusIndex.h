@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveFileStatus.h"
+
+/**
+ * Changed files of the last status refresh, keyed by long package name. Only .uasset/.umap files are kept
+ * and names are interned as FName, so an entry costs a few bytes regardless of path length even at 100k+
+ * changed packages. Built on the status thread and published immutable, so lookups need no locking.
+ */
+class FSafeSaveFileStatusIndex
+{
+public:
+	/** Accumulates entries while status output is parsed; a cheap checksum lets an unchanged result be skipped. */
+	class FBuilder
+	{
+	public:
+		explicit FBuilder(const FString& InRepoRoot);
+
+		/** Path relative to the repository root, as printed by git (UTF-8, '/' separated). */
+		void AddRelative(FAnsiStringView RelativePath, ESafeSaveFileStatus Status);
+		/** Absolute path, as printed by cm. */
+		void AddAbsolute(const FString& Filename, ESafeSaveFileStatus Status);
+		/** Takes over the entries of another repository's builder (nested repositories and submodules). */
+		void Append(const FBuilder& Other);
+
+		uint32 GetChecksum() const { return Checksum; }
+		int32 NumEntries() const { return Entries.Num(); }
+
+		/** Resolves the collected files to package names. */
+		TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> Build() const;
+
+	private:
+		FString RepoRoot;
+		uint32 Checksum = 0;
+		TArray<TPair<FString, ESafeSaveFileStatus>> Entries;
+	};
+
+	ESafeSaveFileStatus Find(FName PackageName) const
+	{
+		const ESafeSaveFileStatus* Status = Entries.Find(PackageName);
+		return Status ? *Status : ESafeSaveFileStatus::None;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+	uint32 GetChecksum() const { return Checksum; }
+
+	/** Visits every (package name, status) entry, e.g. to persist the index. */
+	template <typename FunctorType>
+	void ForEach(FunctorType&& Func) const
+	{
+		for (const TPair<FName, ESafeSaveFileStatus>& Entry : Entries)
+		{
+			Func(Entry.Key, Entry.Value);
+		}
+	}
+
+	/** Recreates a persisted index. */
+	static TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> FromEntries(TMap<FName, ESafeSaveFileStatus>&& InEntries, uint32 InChecksum);
+
+	/** Union of two indexes; a package present in both gets both sets of flags. */
+	static TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> Combine(const FSafeSaveFileStatusIndex& A, const FSafeSaveFileStatusIndex& B);
+
+private:
+	TMap<FName, ESafeSaveFileStatus> Entries;
+	uint32 Checksum = 0;
+};
+
+using FSafeSaveFileStatusIndexPtr = TSharedPtr<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe>;
@@ -0,0 +1,280 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveGitRepository.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	const FString HeadsPrefix = TEXT("refs/heads/");
+	const FString SymbolicRefPrefix = TEXT("ref:");
+	constexpr int32 MaxSymbolicRefDepth = 5;
+
+	FString ReadTrimmedFile(const FString& Filename)
+	{
+		FString Contents;
+		if (FFileHelper::LoadFileToString(Contents, *Filename))
+		{
+			Contents.TrimStartAndEndInline();
+		}
+		return Contents;
+	}
+
+	bool IsObjectId(const FString& Text)
+	{
+		if (Text.Len() != 40 && Text.Len() != 64)
+		{
+			return false;
+		}
+
+		for (const TCHAR Char : Text)
+		{
+			if (!FChar::IsHexDigit(Char))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FString StripHeadsPrefix(const FString& RefName)
+	{
+		return RefName.StartsWith(HeadsPrefix, ESearchCase::CaseSensitive) ? RefName.RightChop(HeadsPrefix.Len()) : RefName;
+	}
+
+	FString UnquoteConfigValue(const FString& Value)
+	{
+		FString Result = Value;
+		Result.TrimStartAndEndInline();
+		if (Result.Len() >= 2 && Result.StartsWith(TEXT("\"")) && Result.EndsWith(TEXT("\"")))
+		{
+			Result = Result.Mid(1, Result.Len() - 2);
+		}
+		return Result;
+	}
+}
+
+bool FSafeSaveGitRepository::FindRepositoryRoot(const FString& StartDir, FString& OutRepoRoot)
+{
+	FString Dir = FPaths::ConvertRelativePathToFull(StartDir);
+	FPaths::NormalizeDirectoryName(Dir);
+
+	while (!Dir.IsEmpty())
+	{
+		if (!ResolveGitDir(Dir).IsEmpty())
+		{
+			OutRepoRoot = Dir;
+			return true;
+		}
+
+		const FString Parent = FPaths::GetPath(Dir);
+		if (Parent.IsEmpty() || Parent == Dir)
+		{
+			break;
+		}
+		Dir = Parent;
+	}
+
+	return false;
+}
+
+FString FSafeSaveGitRepository::ResolveGitDir(const FString& RepoRoot)
+{
+	const FString DotGit = RepoRoot / TEXT(".git");
+	if (FPaths::DirectoryExists(DotGit))
+	{
+		return DotGit;
+	}
+
+	if (FPaths::FileExists(DotGit))
+	{
+		FString Pointer = ReadTrimmedFile(DotGit);
+		if (Pointer.RemoveFromStart(TEXT("gitdir:")))
+		{
+			Pointer.TrimStartAndEndInline();
+			FString GitDir = FPaths::ConvertRelativePathToFull(RepoRoot, Pointer);
+			FPaths::NormalizeDirectoryName(GitDir);
+			return FPaths::DirectoryExists(GitDir) ? GitDir : FString();
+		}
+	}
+
+	return FString();
+}
+
+FString FSafeSaveGitRepository::ResolveCommonGitDir(const FString& GitDir)
+{
+	const FString Pointer = ReadTrimmedFile(GitDir / TEXT("commondir"));
+	if (Pointer.IsEmpty())
+	{
+		return GitDir;
+	}
+
+	FString CommonDir = FPaths::ConvertRelativePathToFull(GitDir, Pointer);
+	FPaths::NormalizeDirectoryName(CommonDir);
+	return FPaths::DirectoryExists(CommonDir) ? CommonDir : GitDir;
+}
+
+bool FSafeSaveGitRepository::ReadHead(const FString& RepoRoot, FHeadInfo& OutHead)
+{
+	OutHead = FHeadInfo();
+
+	const FString GitDir = ResolveGitDir(RepoRoot);
+	if (GitDir.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString CommonDir = ResolveCommonGitDir(GitDir);
+	FString Head = ReadTrimmedFile(GitDir / TEXT("HEAD"));
+	if (Head.IsEmpty())
+	{
+		return false;
+	}
+
+	if (Head.RemoveFromStart(SymbolicRefPrefix))
+	{
+		Head.TrimStartAndEndInline();
+		OutHead.Branch = StripHeadsPrefix(Head);
+		OutHead.HeadOid = ResolveRef(GitDir, CommonDir, Head);
+	}
+	else if (IsObjectId(Head))
+	{
+		OutHead.bDetached = true;
+		OutHead.Branch = TEXT("(detached)");
+		OutHead.HeadOid = Head;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (ReadBranchConfig(CommonDir, OutHead.Branch, OutHead.RemoteName, OutHead.MergeRef))
+	{
+		const FString MergeBranch = StripHeadsPrefix(OutHead.MergeRef);
+		if (OutHead.RemoteName == TEXT("."))
+		{
+			OutHead.UpstreamRef = OutHead.MergeRef;
+			OutHead.UpstreamName = MergeBranch;
+		}
+		else
+		{
+			OutHead.UpstreamRef = FString::Printf(TEXT("refs/remotes/%s/%s"), *OutHead.RemoteName, *MergeBranch);
+			OutHead.UpstreamName = FString::Printf(TEXT("%s/%s"), *OutHead.RemoteName, *MergeBranch);
+		}
+
+		OutHead.bHasUpstream = true;
+		OutHead.UpstreamOid = ResolveRef(GitDir, CommonDir, OutHead.UpstreamRef);
+	}
+
+	return true;
+}
+
+FString FSafeSaveGitRepository::ResolveRef(const FString& GitDir, const FString& CommonDir, const FString& RefName)
+{
+	FString Ref = RefName;
+	for (int32 Depth = 0; Depth < MaxSymbolicRefDepth; ++Depth)
+	{
+		// Refs under refs/ are shared between worktrees; pseudo refs such as HEAD live in the per-worktree git dir.
+		const FString& RefDir = Ref.StartsWith(TEXT("refs/"), ESearchCase::CaseSensitive) ? CommonDir : GitDir;
+		FString Value = ReadTrimmedFile(RefDir / Ref);
+
+		if (Value.IsEmpty())
+		{
+			return FindPackedRef(CommonDir, Ref);
+		}
+
+		if (!Value.RemoveFromStart(SymbolicRefPrefix))
+		{
+			return IsObjectId(Value) ? Value : FString();
+		}
+
+		Value.TrimStartAndEndInline();
+		Ref = Value;
+	}
+
+	return FString();
+}
+
+bool FSafeSaveGitRepository::ReadBranchConfig(const FString& CommonDir, const FString& Branch, FString& OutRemote, FString& OutMerge)
+{
+	TArray<FString> Lines;
+	if (Branch.IsEmpty() || !FFileHelper::LoadFileToStringArray(Lines, *(CommonDir / TEXT("config"))))
+	{
+		return false;
+	}
+
+	const FString SectionHeader = FString::Printf(TEXT("[branch \"%s\"]"), *Branch);
+	bool bInSection = false;
+
+	for (const FString& RawLine : Lines)
+	{
+		FString Line = RawLine;
+		Line.TrimStartAndEndInline();
+
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")) || Line.StartsWith(TEXT(";")))
+		{
+			continue;
+		}
+
+		if (Line.StartsWith(TEXT("[")))
+		{
+			// Section names are case-insensitive, subsection (branch) names are not.
+			bInSection = Line.Len() == SectionHeader.Len()
+				&& Line.Left(8).Equals(TEXT("[branch "), ESearchCase::IgnoreCase)
+				&& Line.Mid(8).Equals(SectionHeader.Mid(8), ESearchCase::CaseSensitive);
+			continue;
+		}
+
+		if (!bInSection)
+		{
+			continue;
+		}
+
+		FString Key;
+		FString Value;
+		if (Line.Split(TEXT("="), &Key, &Value))
+		{
+			Key.TrimStartAndEndInline();
+			if (Key.Equals(TEXT("remote"), ESearchCase::IgnoreCase))
+			{
+				OutRemote = UnquoteConfigValue(Value);
+			}
+			else if (Key.Equals(TEXT("merge"), ESearchCase::IgnoreCase))
+			{
+				OutMerge = UnquoteConfigValue(Value);
+			}
+		}
+	}
+
+	return !OutRemote.IsEmpty() && !OutMerge.IsEmpty();
+}
+
+FString FSafeSaveGitRepository::FindPackedRef(const FString& CommonDir, const FString& RefName)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *(CommonDir / TEXT("packed-refs"))))
+	{
+		return FString();
+	}
+
+	for (const FString& Line : Lines)
+	{
+		if (Line.IsEmpty() || Line[0] == TEXT('#') || Line[0] == TEXT('^'))
+		{
+			continue;
+		}
+
+		int32 SpaceIndex = INDEX_NONE;
+		if (Line.FindChar(TEXT(' '), SpaceIndex)
+			&& Line.Len() - SpaceIndex - 1 == RefName.Len()
+			&& FCString::Strncmp(*Line + SpaceIndex + 1, *RefName, RefName.Len()) == 0)
+		{
+			const FString Oid = Line.Left(SpaceIndex);
+			return IsObjectId(Oid) ? Oid : FString();
+		}
+	}
+
+	return FString();
+}
@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reads git repository metadata (work tree root, HEAD, refs, branch tracking config) straight from the
+ * .git directory, so the data `rev-parse` and the `# branch.*` status headers provide costs no process spawn.
+ */
+class FSafeSaveGitRepository
+{
+public:
+	struct FHeadInfo
+	{
+		FString Branch;
+		FString HeadOid;
+		FString UpstreamName;
+		FString UpstreamRef;
+		FString UpstreamOid;
+		FString RemoteName;
+		FString MergeRef;
+		bool bDetached = false;
+		bool bHasUpstream = false;
+	};
+
+	/** In-process equivalent of `git rev-parse --show-toplevel`: walks up from StartDir to the first work tree root. */
+	static bool FindRepositoryRoot(const FString& StartDir, FString& OutRepoRoot);
+
+	/** Resolves the git directory for a work tree, following `gitdir:` files used by worktrees and submodules. */
+	static FString ResolveGitDir(const FString& RepoRoot);
+
+	/** Resolves the directory holding refs, packed-refs and config (differs from the git dir for linked worktrees). */
+	static FString ResolveCommonGitDir(const FString& GitDir);
+
+	/** Reads HEAD, the current branch's upstream configuration and both commit ids. */
+	static bool ReadHead(const FString& RepoRoot, FHeadInfo& OutHead);
+
+	/** Resolves a full ref name (e.g. refs/heads/main) to a commit id through loose refs and packed-refs. */
+	static FString ResolveRef(const FString& GitDir, const FString& CommonDir, const FString& RefName);
+
+private:
+	static bool ReadBranchConfig(const FString& CommonDir, const FString& Branch, FString& OutRemote, FString& OutMerge);
+	static FString FindPackedRef(const FString& CommonDir, const FString& RefName);
+};
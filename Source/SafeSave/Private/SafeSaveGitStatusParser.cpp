@@ -0,0 +1,225 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveGitStatusParser.h"
+
+#include "SafeSaveSourceControlStatus.h"
+#include "SafeSaveStats.h"
+
+namespace
+{
+	FString ToFString(FAnsiStringView View)
+	{
+		const FUTF8ToTCHAR Converted(View.GetData(), View.Len());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	int32 ParseCount(FAnsiStringView View)
+	{
+		int32 Value = 0;
+		for (const ANSICHAR Char : View)
+		{
+			if (Char < '0' || Char > '9')
+			{
+				break;
+			}
+			Value = Value * 10 + (Char - '0');
+		}
+		return Value;
+	}
+
+	/** Returns what follows the first NumFields space-separated fields, i.e. the path of a status entry. */
+	FAnsiStringView SkipFields(FAnsiStringView Record, int32 NumFields)
+	{
+		for (int32 Index = 0; Index < Record.Len(); ++Index)
+		{
+			if (Record[Index] == ' ' && --NumFields == 0)
+			{
+				return Record.RightChop(Index + 1);
+			}
+		}
+		return FAnsiStringView();
+	}
+}
+
+FSafeSaveGitStatusParser::FSafeSaveGitStatusParser(FSafeSaveSourceControlStatus& InStatus)
+	: Status(InStatus)
+{
+}
+
+void FSafeSaveGitStatusParser::Feed(const uint8* Data, int32 Num)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_ParseGitStatus, FSafeSaveGitStatusParser::Feed);
+
+	int32 RecordStart = 0;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (Data[Index] != 0)
+		{
+			continue;
+		}
+
+		const ANSICHAR* RecordData = reinterpret_cast<const ANSICHAR*>(Data + RecordStart);
+		const int32 RecordLen = Index - RecordStart;
+
+		if (Pending.Num() > 0)
+		{
+			Pending.Append(Data + RecordStart, RecordLen);
+			HandleRecord(FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Pending.GetData()), Pending.Num()));
+			Pending.Reset();
+		}
+		else
+		{
+			HandleRecord(FAnsiStringView(RecordData, RecordLen));
+		}
+
+		RecordStart = Index + 1;
+	}
+
+	if (RecordStart < Num)
+	{
+		Pending.Append(Data + RecordStart, Num - RecordStart);
+	}
+}
+
+void FSafeSaveGitStatusParser::Finish()
+{
+	if (Pending.Num() > 0)
+	{
+		HandleRecord(FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Pending.GetData()), Pending.Num()));
+		Pending.Reset();
+	}
+	bSkipNextRecord = false;
+
+	FSafeSaveStats::RecordParsedEntries(NumEntries);
+	NumEntries = 0;
+}
+
+void FSafeSaveGitStatusParser::Parse(TArrayView<const uint8> Output, FSafeSaveSourceControlStatus& Status)
+{
+	FSafeSaveGitStatusParser Parser(Status);
+	Parser.Feed(Output.GetData(), Output.Num());
+	Parser.Finish();
+}
+
+void FSafeSaveGitStatusParser::HandleRecord(FAnsiStringView Record)
+{
+	if (bSkipNextRecord)
+	{
+		bSkipNextRecord = false;
+		return;
+	}
+
+	if (Record.Len() < 2 || Record[1] != ' ')
+	{
+		return;
+	}
+
+	NumEntries += Record[0] != '#' ? 1 : 0;
+
+	switch (Record[0])
+	{
+	case '#':
+		HandleHeader(Record);
+		break;
+
+	case '1':
+	case '2':
+		// "1 XY ..." / "2 XY ..."; X is the index (staged) state, Y the work tree state.
+		if (Record.Len() > 3)
+		{
+			const ANSICHAR X = Record[2];
+			const ANSICHAR Y = Record[3];
+			ESafeSaveFileStatus FileStatus = ESafeSaveFileStatus::None;
+
+			if (X != '.')
+			{
+				Status.Staged++;
+				FileStatus |= ESafeSaveFileStatus::Staged;
+			}
+			if (Y != '.')
+			{
+				Status.Unstaged++;
+				FileStatus |= ESafeSaveFileStatus::Modified;
+			}
+			if (X == 'U' || Y == 'U')
+			{
+				Status.bHasConflicts = true;
+				FileStatus |= ESafeSaveFileStatus::Conflicted;
+			}
+
+			// "1 XY sub mH mI mW hH hI path"; renames carry an extra score field before the path.
+			if (FileIndexBuilder)
+			{
+				FileIndexBuilder->AddRelative(SkipFields(Record, Record[0] == '2' ? 9 : 8), FileStatus);
+			}
+		}
+		bSkipNextRecord = Record[0] == '2';
+		break;
+
+	case 'u':
+		Status.bHasConflicts = true;
+		if (FileIndexBuilder)
+		{
+			// "u XY sub m1 m2 m3 mW h1 h2 h3 path"
+			FileIndexBuilder->AddRelative(SkipFields(Record, 10), ESafeSaveFileStatus::Conflicted);
+		}
+		break;
+
+	case '?':
+		Status.Untracked++;
+		if (FileIndexBuilder)
+		{
+			// Untracked directories are reported collapsed ("dir/"), so new packages inside them are not indexed.
+			FileIndexBuilder->AddRelative(Record.RightChop(2), ESafeSaveFileStatus::Untracked);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void FSafeSaveGitStatusParser::HandleHeader(FAnsiStringView Header)
+{
+	static const FAnsiStringView BranchOid("# branch.oid ");
+	static const FAnsiStringView BranchHead("# branch.head ");
+	static const FAnsiStringView BranchUpstream("# branch.upstream ");
+	static const FAnsiStringView BranchAb("# branch.ab ");
+
+	if (Header.StartsWith(BranchOid, ESearchCase::CaseSensitive))
+	{
+		// "(initial)" before the first commit.
+		FAnsiStringView Oid = Header.RightChop(BranchOid.Len());
+		Oid.TrimStartAndEndInline();
+		Status.HeadCommit = Oid.StartsWith('(') ? FString() : ToFString(Oid);
+	}
+	else if (Header.StartsWith(BranchHead, ESearchCase::CaseSensitive))
+	{
+		FAnsiStringView Branch = Header.RightChop(BranchHead.Len());
+		Branch.TrimStartAndEndInline();
+		Status.Branch = ToFString(Branch);
+	}
+	else if (Header.StartsWith(BranchUpstream, ESearchCase::CaseSensitive))
+	{
+		Status.bHasUpstream = true;
+	}
+	else if (Header.StartsWith(BranchAb, ESearchCase::CaseSensitive))
+	{
+		// "# branch.ab +<ahead> -<behind>"
+		FAnsiStringView Ab = Header.RightChop(BranchAb.Len());
+		while (!Ab.IsEmpty())
+		{
+			int32 SpaceIndex = INDEX_NONE;
+			const FAnsiStringView Part = Ab.FindChar(' ', SpaceIndex) ? Ab.Left(SpaceIndex) : Ab;
+			if (Part.Len() > 1 && Part[0] == '+')
+			{
+				Status.Ahead = ParseCount(Part.RightChop(1));
+			}
+			else if (Part.Len() > 1 && Part[0] == '-')
+			{
+				Status.Behind = ParseCount(Part.RightChop(1));
+			}
+			Ab = SpaceIndex == INDEX_NONE ? FAnsiStringView() : Ab.RightChop(SpaceIndex + 1);
+		}
+	}
+}
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveFileStatusIndex.h"
+
+struct FSafeSaveSourceControlStatus;
+
+/**
+ * Single-pass parser for `git status --porcelain=v2 -z`. Records are NUL-terminated and paths are never
+ * quoted, so entries are classified straight from the byte stream without decoding paths or splitting lines;
+ * only the few `# branch.*` headers are converted to FString. Output can be fed in arbitrary chunks as it
+ * arrives from the pipe.
+ */
+class FSafeSaveGitStatusParser
+{
+public:
+	explicit FSafeSaveGitStatusParser(FSafeSaveSourceControlStatus& InStatus);
+
+	/** Also reports every changed path to Builder, which must outlive the parser. */
+	void SetFileIndexBuilder(FSafeSaveFileStatusIndex::FBuilder* InBuilder) { FileIndexBuilder = InBuilder; }
+
+	/** Consumes the next chunk of output; a record may be split across chunks. */
+	void Feed(const uint8* Data, int32 Num);
+
+	/** Handles a trailing record that was not NUL-terminated. */
+	void Finish();
+
+	/** Parses a complete output buffer into Status. */
+	static void Parse(TArrayView<const uint8> Output, FSafeSaveSourceControlStatus& Status);
+
+private:
+	void HandleRecord(FAnsiStringView Record);
+	void HandleHeader(FAnsiStringView Header);
+
+	FSafeSaveSourceControlStatus& Status;
+	FSafeSaveFileStatusIndex::FBuilder* FileIndexBuilder = nullptr;
+	/** Tail of a record whose terminator has not arrived yet. */
+	TArray<uint8> Pending;
+	/** Renamed/copied ("2") entries are followed by a separate field holding the original path. */
+	bool bSkipNextRecord = false;
+	int32 NumEntries = 0;
+};
@@ -0,0 +1,513 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveGitStatusQuery.h"
+
+#include "SafeSaveCommandRunner.h"
+#include "SafeSaveDetectionCache.h"
+#include "SafeSaveGitRepository.h"
+#include "SafeSaveGitStatusParser.h"
+#include "SafeSaveSettings.h"
+#include "SafeSaveSourceControlStatus.h"
+#include "SafeSaveStats.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Value of a git boolean config entry; unset for empty values and for anything else (e.g. an fsmonitor hook path). */
+	TOptional<bool> ParseGitBool(const FString& Value)
+	{
+		if (Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("yes"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("on"), ESearchCase::IgnoreCase) || Value == TEXT("1"))
+		{
+			return true;
+		}
+		if (Value.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("no"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("off"), ESearchCase::IgnoreCase) || Value == TEXT("0"))
+		{
+			return false;
+		}
+		return TOptional<bool>();
+	}
+}
+
+FSafeSaveGitStatusQuery::FSafeSaveGitStatusQuery(const FSafeSaveCommandRunner& InRunner, FSafeSaveDetectionCache& InDetectionCache)
+	: Runner(InRunner)
+	, DetectionCache(InDetectionCache)
+{
+}
+
+bool FSafeSaveGitStatusQuery::Query(const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_GitStatus, FSafeSaveGitStatusQuery::Query);
+
+	OutStatus = FSafeSaveSourceControlStatus();
+	OutStatus.Provider = ESafeSaveSourceControlProvider::Git;
+
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const bool bInProcessMetadata = Settings && Settings->GitBackend == ESafeSaveGitBackend::InProcessMetadata;
+
+	FSafeSaveDetectionCache::FDetection Detection;
+	const bool bFromCache = DetectionCache.Get(ESafeSaveSourceControlProvider::Git, ProjectDir, Detection);
+	FString InProcessRoot;
+
+	if (bFromCache)
+	{
+		OutStatus.bClientAvailable = true;
+		OutStatus.bRepo = true;
+		OutStatus.RepoRoot = Detection.RepoRoot;
+	}
+	else if (bInProcessMetadata && FSafeSaveGitRepository::FindRepositoryRoot(ProjectDir, InProcessRoot))
+	{
+		// Client availability is confirmed by the status call below.
+		OutStatus.bClientAvailable = true;
+		OutStatus.bRepo = true;
+		OutStatus.RepoRoot = InProcessRoot;
+
+		Detection.Provider = ESafeSaveSourceControlProvider::Git;
+		Detection.ProjectDir = ProjectDir;
+		Detection.RepoRoot = InProcessRoot;
+		DetectionCache.Store(Detection);
+	}
+	else
+	{
+		const bool bGitLaunched = Runner.RunGit(TEXT("rev-parse --show-toplevel"), ProjectDir, StdOut, StdErr, ExitCode);
+		if (!bGitLaunched)
+		{
+			OutStatus.bClientAvailable = false;
+			OutError = TEXT("Git executable not found.");
+			OutStatus.LastError = OutError;
+			return false;
+		}
+
+		OutStatus.bClientAvailable = true;
+
+		if (ExitCode != 0)
+		{
+			OutStatus.bRepo = false;
+			OutError = StdErr.TrimStartAndEnd();
+			OutStatus.LastError = OutError;
+			return false;
+		}
+
+		OutStatus.bRepo = true;
+		OutStatus.RepoRoot = StdOut.TrimStartAndEnd();
+
+		Detection.Provider = ESafeSaveSourceControlProvider::Git;
+		Detection.ProjectDir = ProjectDir;
+		Detection.RepoRoot = OutStatus.RepoRoot;
+		DetectionCache.Store(Detection);
+
+		StdOut.Reset();
+		StdErr.Reset();
+		ExitCode = 0;
+	}
+
+	// With in-process metadata the branch headers come from .git; when HEAD and upstream point at the same
+	// commit there is nothing to count, so -b (and its history walk for ahead/behind) can be skipped.
+	FSafeSaveGitRepository::FHeadInfo Head;
+	const bool bHeadFromMetadata = bInProcessMetadata
+		&& FSafeSaveGitRepository::ReadHead(OutStatus.RepoRoot, Head)
+		&& (!Head.bHasUpstream || (!Head.HeadOid.IsEmpty() && Head.HeadOid == Head.UpstreamOid));
+
+	if (bHeadFromMetadata)
+	{
+		OutStatus.Branch = Head.Branch;
+		OutStatus.HeadCommit = Head.HeadOid;
+		OutStatus.UpstreamCommit = Head.UpstreamOid;
+		OutStatus.bHasUpstream = Head.bHasUpstream;
+	}
+	const bool bLazyAheadBehind = !bHeadFromMetadata && Settings && Settings->bLazyAheadBehind;
+
+	const ESafeSaveGitStatusScanMode ScanMode = Settings ? Settings->GitStatusScanMode : ESafeSaveGitStatusScanMode::Full;
+	FString StatusArgs;
+	bool bWritesIndex = false;
+
+	if (ScanMode == ESafeSaveGitStatusScanMode::Accelerated)
+	{
+		// What the repository configures wins: an explicit false stays off (e.g. a filesystem the untracked cache
+		// cannot trust), and an fsmonitor hook such as Watchman is used as is instead of the built-in daemon.
+		const FCapabilities Capabilities = GetCapabilities(OutStatus.RepoRoot);
+		const TOptional<bool> ConfiguredUntrackedCache = ParseGitBool(Capabilities.ConfiguredUntrackedCache);
+		const TOptional<bool> ConfiguredFsMonitor = ParseGitBool(Capabilities.ConfiguredFsMonitor);
+		TArray<FString> Features;
+		if (Capabilities.bUntrackedCache && ConfiguredUntrackedCache.Get(true))
+		{
+			if (!ConfiguredUntrackedCache.IsSet())
+			{
+				StatusArgs += TEXT("-c core.untrackedCache=true ");
+			}
+			Features.Add(TEXT("untracked cache"));
+		}
+		if (!Capabilities.ConfiguredFsMonitor.IsEmpty() && !ConfiguredFsMonitor.IsSet())
+		{
+			Features.Add(TEXT("fsmonitor hook"));
+		}
+		else if (Capabilities.bFsMonitor && ConfiguredFsMonitor.Get(true))
+		{
+			if (!ConfiguredFsMonitor.IsSet())
+			{
+				StatusArgs += TEXT("-c core.fsmonitor=true ");
+			}
+			Features.Add(TEXT("fsmonitor"));
+		}
+
+		if (Features.Num() > 0)
+		{
+			// Both caches persist through the index, so optional index writes must stay enabled here.
+			bWritesIndex = true;
+			OutStatus.ScanMode = FString::Join(Features, TEXT(" + "));
+		}
+		else
+		{
+			StatusArgs += TEXT("--no-optional-locks ");
+			OutStatus.ScanMode = FString::Printf(TEXT("full (git %s supports no acceleration)"), *Capabilities.Version);
+		}
+	}
+	else
+	{
+		StatusArgs += TEXT("--no-optional-locks ");
+		OutStatus.ScanMode = ScanMode == ESafeSaveGitStatusScanMode::TrackedOnly ? TEXT("tracked only") : TEXT("full");
+	}
+
+	// -z: NUL-terminated records with unquoted paths, parsed as they stream in from the pipe.
+	StatusArgs += TEXT("status --porcelain=v2 -z");
+	if (!bHeadFromMetadata)
+	{
+		StatusArgs += bLazyAheadBehind ? TEXT(" -b --no-ahead-behind") : TEXT(" -b");
+	}
+	if (ScanMode == ESafeSaveGitStatusScanMode::TrackedOnly)
+	{
+		StatusArgs += TEXT(" --untracked-files=no");
+	}
+
+	int32 NumScopePaths = 0;
+	const FString Pathspecs = BuildScopePathspecs(OutStatus.RepoRoot, ProjectDir, NumScopePaths);
+	StatusArgs += Pathspecs;
+
+	FSafeSaveFileStatusIndex::FBuilder IndexBuilder(OutStatus.RepoRoot);
+	FSafeSaveGitStatusParser Parser(OutStatus);
+	Parser.SetFileIndexBuilder(&IndexBuilder);
+	const bool bStatusOk = Runner.RunGitStreaming(StatusArgs, OutStatus.RepoRoot, [&Parser](const uint8* Data, int32 Num)
+	{
+		Parser.Feed(Data, Num);
+	}, StdErr, ExitCode);
+	if (!bStatusOk)
+	{
+		DetectionCache.Invalidate();
+		OutStatus.bClientAvailable = false;
+		OutError = TEXT("Git executable not found.");
+		OutStatus.LastError = OutError;
+		return false;
+	}
+
+	if (ExitCode == 0)
+	{
+		if (bWritesIndex)
+		{
+			RecordSelfWrittenIndex(OutStatus.RepoRoot);
+		}
+
+		Parser.Finish();
+		OutStatus.FileIndex = DetectionCache.ResolveFileIndex(OutStatus.RepoRoot, IndexBuilder);
+
+		if (bLazyAheadBehind && OutStatus.bHasUpstream)
+		{
+			UpdateAheadBehind(OutStatus);
+		}
+
+		if (ScanMode == ESafeSaveGitStatusScanMode::TrackedOnly)
+		{
+			const double ScanInterval = FMath::Max(10.0, (double)Settings->UntrackedScanIntervalSeconds);
+			OutStatus.Untracked = GetUntrackedCount(OutStatus.RepoRoot, Pathspecs, ScanInterval);
+			OutStatus.ScanMode = FString::Printf(TEXT("tracked only (untracked every %ds)"), (int32)ScanInterval);
+		}
+		if (NumScopePaths > 0)
+		{
+			OutStatus.ScanMode += FString::Printf(TEXT(", scoped to %d path(s)"), NumScopePaths);
+		}
+	}
+	else
+	{
+		if (bFromCache)
+		{
+			// The cached root may be stale (repo moved or deleted); detect again before reporting the failure.
+			DetectionCache.Invalidate();
+			return Query(ProjectDir, OutStatus, OutError);
+		}
+
+		OutStatus.LastError = StdErr.TrimStartAndEnd();
+		OutError = OutStatus.LastError;
+	}
+
+	return true;
+}
+
+FSafeSaveGitStatusQuery::FCapabilities FSafeSaveGitStatusQuery::GetCapabilities(const FString& WorkingDir) const
+{
+	FCapabilities Capabilities;
+	{
+		FScopeLock Lock(&CacheLock);
+		if (CachedCapabilities.bProbed && CachedCapabilities.RepoRoot == WorkingDir)
+		{
+			return CachedCapabilities;
+		}
+		Capabilities = CachedCapabilities;
+	}
+
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+	if (!Capabilities.bProbed && Runner.RunGit(TEXT("version"), WorkingDir, StdOut, StdErr, ExitCode) && ExitCode == 0)
+	{
+		// "git version 2.43.0.windows.1"
+		Capabilities.Version = StdOut.TrimStartAndEnd();
+		Capabilities.Version.RemoveFromStart(TEXT("git version "));
+
+		TArray<FString> Parts;
+		Capabilities.Version.ParseIntoArray(Parts, TEXT("."), true);
+		const int32 Major = Parts.Num() > 0 ? FCString::Atoi(*Parts[0]) : 0;
+		const int32 Minor = Parts.Num() > 1 ? FCString::Atoi(*Parts[1]) : 0;
+		const auto IsAtLeast = [Major, Minor](int32 InMajor, int32 InMinor)
+		{
+			return Major > InMajor || (Major == InMajor && Minor >= InMinor);
+		};
+
+		Capabilities.bUntrackedCache = IsAtLeast(2, 8);
+		Capabilities.bNoWriteFetchHead = IsAtLeast(2, 29);
+
+		// The daemon is only compiled into some builds (Windows and macOS); others do not know the command or say
+		// it is not supported. "Not watching" just means it is not running yet; core.fsmonitor=true starts it.
+		if (IsAtLeast(2, 36))
+		{
+			FString DaemonOut;
+			FString DaemonErr;
+			int32 DaemonExitCode = 0;
+			if (Runner.RunGit(TEXT("fsmonitor--daemon status"), WorkingDir, DaemonOut, DaemonErr, DaemonExitCode))
+			{
+				const FString Output = DaemonOut + DaemonErr;
+				Capabilities.bFsMonitor = !Output.Contains(TEXT("not supported")) && !Output.Contains(TEXT("is not a git command"));
+			}
+		}
+	}
+	Capabilities.bProbed = true;
+
+	// Only the two keys matter; a repository without either set prints nothing and exits 1.
+	Capabilities.RepoRoot = WorkingDir;
+	Capabilities.ConfiguredUntrackedCache.Reset();
+	Capabilities.ConfiguredFsMonitor.Reset();
+	StdOut.Reset();
+	StdErr.Reset();
+	if (Runner.RunGit(TEXT("config --get-regexp \"^core\\.(untrackedcache|fsmonitor)$\""), WorkingDir, StdOut, StdErr, ExitCode) && ExitCode == 0)
+	{
+		TArray<FString> Lines;
+		StdOut.ParseIntoArrayLines(Lines, true);
+		for (const FString& Line : Lines)
+		{
+			FString Key;
+			FString Value;
+			if (!Line.Split(TEXT(" "), &Key, &Value))
+			{
+				Key = Line;
+			}
+			(Key == TEXT("core.untrackedcache") ? Capabilities.ConfiguredUntrackedCache : Capabilities.ConfiguredFsMonitor) = Value.TrimStartAndEnd();
+		}
+	}
+
+	FScopeLock Lock(&CacheLock);
+	CachedCapabilities = Capabilities;
+	return Capabilities;
+}
+
+void FSafeSaveGitStatusQuery::ResetRepositoryConfig() const
+{
+	FScopeLock Lock(&CacheLock);
+	CachedCapabilities.RepoRoot.Reset();
+}
+
+int32 FSafeSaveGitStatusQuery::GetUntrackedCount(const FString& RepoRoot, const FString& Pathspecs, double ScanIntervalSeconds) const
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	{
+		FScopeLock Lock(&CacheLock);
+		if (UntrackedScanCache.RepoRoot == RepoRoot && UntrackedScanCache.Pathspecs == Pathspecs && NowSeconds - UntrackedScanCache.LastScanSeconds < ScanIntervalSeconds)
+		{
+			return UntrackedScanCache.Count;
+		}
+	}
+
+	// Same collapsing of untracked directories as status' default --untracked-files=normal.
+	FString StdErr;
+	int32 ExitCode = 0;
+	int32 Count = 0;
+	const FString Args = TEXT("--no-optional-locks ls-files -z --others --exclude-standard --directory --no-empty-directory") + Pathspecs;
+	const bool bScanOk = Runner.RunGitStreaming(Args, RepoRoot, [&Count](const uint8* Data, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Count += Data[Index] == 0 ? 1 : 0;
+		}
+	}, StdErr, ExitCode);
+
+	FScopeLock Lock(&CacheLock);
+	if (bScanOk && ExitCode == 0)
+	{
+		UntrackedScanCache.RepoRoot = RepoRoot;
+		UntrackedScanCache.Pathspecs = Pathspecs;
+		UntrackedScanCache.Count = Count;
+	}
+	UntrackedScanCache.LastScanSeconds = NowSeconds;
+	return UntrackedScanCache.RepoRoot == RepoRoot && UntrackedScanCache.Pathspecs == Pathspecs ? UntrackedScanCache.Count : 0;
+}
+
+FString FSafeSaveGitStatusQuery::BuildScopePathspecs(const FString& RepoRoot, const FString& ProjectDir, int32& OutNumPaths) const
+{
+	OutNumPaths = 0;
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings || !Settings->bScopeStatusToPaths || Settings->StatusScopePaths.Num() == 0)
+	{
+		return FString();
+	}
+
+	FString Root = RepoRoot;
+	FPaths::NormalizeDirectoryName(Root);
+	Root /= TEXT("");
+
+	FString Pathspecs;
+	for (const FString& ScopePath : Settings->StatusScopePaths)
+	{
+		const FString Trimmed = ScopePath.TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			continue;
+		}
+
+		FString FullPath = FPaths::IsRelative(Trimmed) ? FPaths::ConvertRelativePathToFull(ProjectDir, Trimmed) : Trimmed;
+		FPaths::NormalizeFilename(FullPath);
+
+		// Paths outside the work tree would make git fail the whole status.
+		FString RelativePath = FullPath;
+		if (!FPaths::MakePathRelativeTo(RelativePath, *Root) || RelativePath.StartsWith(TEXT("..")))
+		{
+			continue;
+		}
+
+		// :(top) resolves against the work tree root regardless of git's working directory.
+		Pathspecs += FString::Printf(TEXT(" \":(top)%s\""), RelativePath.IsEmpty() ? TEXT("") : *RelativePath);
+		++OutNumPaths;
+	}
+
+	return OutNumPaths > 0 ? TEXT(" --") + Pathspecs : FString();
+}
+
+void FSafeSaveGitStatusQuery::UpdateAheadBehind(FSafeSaveSourceControlStatus& InOutStatus) const
+{
+	if (InOutStatus.HeadCommit.IsEmpty())
+	{
+		return;
+	}
+
+	// The upstream commit is read from .git when possible; rev-parse is the fallback for layouts we can't read (e.g. reftable).
+	FString UpstreamCommit;
+	FSafeSaveGitRepository::FHeadInfo Head;
+	if (FSafeSaveGitRepository::ReadHead(InOutStatus.RepoRoot, Head) && Head.HeadOid == InOutStatus.HeadCommit)
+	{
+		UpstreamCommit = Head.UpstreamOid;
+	}
+	if (UpstreamCommit.IsEmpty())
+	{
+		FString StdOut;
+		FString StdErr;
+		int32 ExitCode = 0;
+		if (Runner.RunGit(TEXT("rev-parse --verify --quiet @{upstream}"), InOutStatus.RepoRoot, StdOut, StdErr, ExitCode) && ExitCode == 0)
+		{
+			UpstreamCommit = StdOut.TrimStartAndEnd();
+		}
+	}
+
+	if (UpstreamCommit.IsEmpty())
+	{
+		return;
+	}
+
+	InOutStatus.UpstreamCommit = UpstreamCommit;
+	if (UpstreamCommit == InOutStatus.HeadCommit)
+	{
+		InOutStatus.Ahead = 0;
+		InOutStatus.Behind = 0;
+		return;
+	}
+
+	{
+		FScopeLock Lock(&CacheLock);
+		if (AheadBehindCache.HeadCommit == InOutStatus.HeadCommit && AheadBehindCache.UpstreamCommit == UpstreamCommit)
+		{
+			InOutStatus.Ahead = AheadBehindCache.Ahead;
+			InOutStatus.Behind = AheadBehindCache.Behind;
+			return;
+		}
+	}
+
+	// "<ahead>\t<behind>": left side is HEAD, right side the upstream.
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+	const FString Args = FString::Printf(TEXT("rev-list --left-right --count %s...%s"), *InOutStatus.HeadCommit, *UpstreamCommit);
+	if (!Runner.RunGit(Args, InOutStatus.RepoRoot, StdOut, StdErr, ExitCode) || ExitCode != 0)
+	{
+		return;
+	}
+
+	TArray<FString> Counts;
+	StdOut.TrimStartAndEnd().ParseIntoArrayWS(Counts);
+	if (Counts.Num() != 2)
+	{
+		return;
+	}
+
+	InOutStatus.Ahead = FCString::Atoi(*Counts[0]);
+	InOutStatus.Behind = FCString::Atoi(*Counts[1]);
+
+	FScopeLock Lock(&CacheLock);
+	AheadBehindCache.HeadCommit = InOutStatus.HeadCommit;
+	AheadBehindCache.UpstreamCommit = UpstreamCommit;
+	AheadBehindCache.Ahead = InOutStatus.Ahead;
+	AheadBehindCache.Behind = InOutStatus.Behind;
+}
+
+void FSafeSaveGitStatusQuery::RecordSelfWrittenIndex(const FString& RepoRoot) const
+{
+	FIndexStamp Stamp;
+	Stamp.Path = FSafeSaveGitRepository::ResolveGitDir(RepoRoot) / TEXT("index");
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*Stamp.Path);
+	if (StatData.bIsValid)
+	{
+		Stamp.ModificationTime = StatData.ModificationTime;
+		Stamp.Size = StatData.FileSize;
+	}
+
+	FScopeLock Lock(&CacheLock);
+	SelfWrittenIndex = MoveTemp(Stamp);
+}
+
+bool FSafeSaveGitStatusQuery::IsSelfWrittenIndex(const FString& RepoRoot) const
+{
+	if (RepoRoot.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString IndexPath = FSafeSaveGitRepository::ResolveGitDir(RepoRoot) / TEXT("index");
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*IndexPath);
+
+	FScopeLock Lock(&CacheLock);
+	return StatData.bIsValid
+		&& SelfWrittenIndex.Path == IndexPath
+		&& SelfWrittenIndex.Size == StatData.FileSize
+		&& SelfWrittenIndex.ModificationTime == StatData.ModificationTime;
+}
@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FSafeSaveCommandRunner;
+class FSafeSaveDetectionCache;
+struct FSafeSaveSourceControlStatus;
+
+/**
+ * The git side of a status refresh: detects the repository, runs `git status` with the scan mode and
+ * acceleration the settings ask for, and fills in ahead/behind, untracked counts and the per-file index.
+ * Keeps the caches that let a warm poll skip work. Any thread.
+ */
+class FSafeSaveGitStatusQuery
+{
+public:
+	/**
+	 * Status acceleration features of the installed git, probed once per session, and how the repository
+	 * configures them, read again whenever the repository changes.
+	 */
+	struct FCapabilities
+	{
+		bool bProbed = false;
+		bool bUntrackedCache = false;
+		/** The built-in fsmonitor daemon is compiled into this git. */
+		bool bFsMonitor = false;
+		bool bNoWriteFetchHead = false;
+		FString Version;
+		/** Repository the configured values below were read from. */
+		FString RepoRoot;
+		/** core.untrackedCache and core.fsmonitor as set in the repository's config; empty when unset. */
+		FString ConfiguredUntrackedCache;
+		FString ConfiguredFsMonitor;
+	};
+
+	FSafeSaveGitStatusQuery(const FSafeSaveCommandRunner& InRunner, FSafeSaveDetectionCache& InDetectionCache);
+
+	/** Full status of the repository containing ProjectDir. Returns false when there is no git or no repository. */
+	bool Query(const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const;
+
+	FCapabilities GetCapabilities(const FString& WorkingDir) const;
+	/** The repository's core.* settings are read again with the next query; the probed git version is kept. */
+	void ResetRepositoryConfig() const;
+
+	/** Fills Ahead/Behind (and UpstreamCommit) after a --no-ahead-behind status, reusing the last count when neither commit moved. */
+	void UpdateAheadBehind(FSafeSaveSourceControlStatus& InOutStatus) const;
+
+	/** Whether RepoRoot's index is still the one our own accelerated status wrote, so a watcher event for it can be ignored. */
+	bool IsSelfWrittenIndex(const FString& RepoRoot) const;
+
+private:
+	/** Size and modification time of .git/index, as the last accelerated status left it. */
+	struct FIndexStamp
+	{
+		FString Path;
+		FDateTime ModificationTime;
+		int64 Size = -1;
+	};
+
+	/** Untracked count carried between polls while status runs with --untracked-files=no. */
+	struct FUntrackedScanCache
+	{
+		FString RepoRoot;
+		FString Pathspecs;
+		double LastScanSeconds = 0.0;
+		int32 Count = 0;
+	};
+
+	/** Ahead/behind counts for one HEAD/upstream commit pair; recounted only when either commit moves. */
+	struct FAheadBehindCache
+	{
+		FString HeadCommit;
+		FString UpstreamCommit;
+		int32 Ahead = 0;
+		int32 Behind = 0;
+	};
+
+	int32 GetUntrackedCount(const FString& RepoRoot, const FString& Pathspecs, double ScanIntervalSeconds) const;
+	/**
+	 * " -- <paths>" for the configured status scope (relative to ProjectDir) as pathspecs relative to RepoRoot, or
+	 * empty when status covers the whole repository.
+	 */
+	FString BuildScopePathspecs(const FString& RepoRoot, const FString& ProjectDir, int32& OutNumPaths) const;
+	void RecordSelfWrittenIndex(const FString& RepoRoot) const;
+
+	const FSafeSaveCommandRunner& Runner;
+	FSafeSaveDetectionCache& DetectionCache;
+
+	mutable FCapabilities CachedCapabilities;
+	mutable FIndexStamp SelfWrittenIndex;
+	mutable FUntrackedScanCache UntrackedScanCache;
+	mutable FAheadBehindCache AheadBehindCache;
+	mutable FCriticalSection CacheLock;
+};
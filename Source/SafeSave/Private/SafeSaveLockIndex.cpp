@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveLockIndex.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	bool IsPackageFile(const FString& Path)
+	{
+		return Path.EndsWith(TEXT(".uasset"), ESearchCase::IgnoreCase) || Path.EndsWith(TEXT(".umap"), ESearchCase::IgnoreCase);
+	}
+
+	/** Adds the entries of one `git lfs locks` array; bOurs is unset when the server did not verify ownership. */
+	void AddGitLfsLocks(const TArray<TSharedPtr<FJsonValue>>& Locks, const FString& RepoRoot, const FString& CurrentUser, TOptional<bool> bOurs, TFunctionRef<void(const FString&, FSafeSaveFileLock&&)> Add)
+	{
+		for (const TSharedPtr<FJsonValue>& Value : Locks)
+		{
+			const TSharedPtr<FJsonObject>* Lock = nullptr;
+			FString Path;
+			if (!Value.IsValid() || !Value->TryGetObject(Lock) || !(*Lock)->TryGetStringField(TEXT("path"), Path))
+			{
+				continue;
+			}
+
+			FSafeSaveFileLock FileLock;
+			const TSharedPtr<FJsonObject>* Owner = nullptr;
+			if ((*Lock)->TryGetObjectField(TEXT("owner"), Owner))
+			{
+				(*Owner)->TryGetStringField(TEXT("name"), FileLock.Owner);
+			}
+			FileLock.bOwnedByCurrentUser = bOurs.IsSet()
+				? bOurs.GetValue()
+				: (!CurrentUser.IsEmpty() && FileLock.Owner.Equals(CurrentUser, ESearchCase::IgnoreCase));
+
+			Add(RepoRoot / Path, MoveTemp(FileLock));
+		}
+	}
+}
+
+TSharedPtr<const FSafeSaveLockIndex, ESPMode::ThreadSafe> FSafeSaveLockIndex::ParseGitLfsLocks(const FString& Output, const FString& RepoRoot, const FString& CurrentUser)
+{
+	TSharedPtr<FJsonValue> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Output);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FSafeSaveLockIndex, ESPMode::ThreadSafe> Index = MakeShared<FSafeSaveLockIndex, ESPMode::ThreadSafe>();
+	const auto Add = [&Index](const FString& Filename, FSafeSaveFileLock&& Lock)
+	{
+		Index->Add(Filename, MoveTemp(Lock));
+	};
+
+	const TArray<TSharedPtr<FJsonValue>>* Locks = nullptr;
+	const TSharedPtr<FJsonObject>* Verified = nullptr;
+	if (Root->TryGetArray(Locks))
+	{
+		AddGitLfsLocks(*Locks, RepoRoot, CurrentUser, TOptional<bool>(), Add);
+	}
+	else if (Root->TryGetObject(Verified))
+	{
+		if ((*Verified)->TryGetArrayField(TEXT("ours"), Locks))
+		{
+			AddGitLfsLocks(*Locks, RepoRoot, CurrentUser, true, Add);
+		}
+		if ((*Verified)->TryGetArrayField(TEXT("theirs"), Locks))
+		{
+			AddGitLfsLocks(*Locks, RepoRoot, CurrentUser, false, Add);
+		}
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	Index->Entries.Compact();
+	return Index;
+}
+
+TSharedPtr<const FSafeSaveLockIndex, ESPMode::ThreadSafe> FSafeSaveLockIndex::ParsePlasticLocks(const FString& Output, const FString& WorkspaceRoot, const FString& CurrentUser)
+{
+	TSharedRef<FSafeSaveLockIndex, ESPMode::ThreadSafe> Index = MakeShared<FSafeSaveLockIndex, ESPMode::ThreadSafe>();
+
+	TArray<FString> Lines;
+	Output.ParseIntoArrayLines(Lines, true);
+	for (const FString& Line : Lines)
+	{
+		// Owner first: it cannot contain the separator, so everything after it is the path.
+		FString Owner;
+		FString Path;
+		if (!Line.Split(TEXT("|"), &Owner, &Path))
+		{
+			continue;
+		}
+
+		Path.TrimStartAndEndInline();
+		FSafeSaveFileLock FileLock;
+		FileLock.Owner = Owner.TrimStartAndEnd();
+		FileLock.bOwnedByCurrentUser = !CurrentUser.IsEmpty() && FileLock.Owner.Equals(CurrentUser, ESearchCase::IgnoreCase);
+
+		// Server paths ("/Content/Maps/Entry.umap") are relative to the workspace root.
+		if (FPaths::IsRelative(Path) || (Path.StartsWith(TEXT("/")) && !FPaths::FileExists(Path)))
+		{
+			Path = WorkspaceRoot / Path;
+		}
+		Index->Add(Path, MoveTemp(FileLock));
+	}
+
+	Index->Entries.Compact();
+	return Index;
+}
+
+void FSafeSaveLockIndex::Add(const FString& Filename, FSafeSaveFileLock&& Lock)
+{
+	// Locks on non-package files (source, config) are not reported; nothing in the editor asks about them.
+	FString PackageName;
+	if (!IsPackageFile(Filename)
+		|| !FPackageName::TryConvertFilenameToLongPackageName(FPaths::ConvertRelativePathToFull(Filename), PackageName)
+		|| PackageName.Len() >= NAME_SIZE)
+	{
+		return;
+	}
+
+	Entries.Add(FName(*PackageName), MoveTemp(Lock));
+}
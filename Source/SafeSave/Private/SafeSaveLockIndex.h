@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A source control lock on one file. */
+struct FSafeSaveFileLock
+{
+	FString Owner;
+	bool bOwnedByCurrentUser = false;
+};
+
+/**
+ * Every lock in the repository, keyed by long package name, from one batched `git lfs locks` or `cm lock list`
+ * call. Built on the worker thread and published immutable, so the checks made when an asset is opened or
+ * dirtied are answered from memory without a network round-trip.
+ */
+class FSafeSaveLockIndex
+{
+public:
+	/**
+	 * Parses `git lfs locks --verify --json` ({"ours": [...], "theirs": [...]}) or, when the server cannot
+	 * verify ownership, `git lfs locks --json` ([...]); in the latter case owners equal to CurrentUser count as ours.
+	 * Returns null for output that is not lock JSON.
+	 */
+	static TSharedPtr<const FSafeSaveLockIndex, ESPMode::ThreadSafe> ParseGitLfsLocks(const FString& Output, const FString& RepoRoot, const FString& CurrentUser);
+
+	/** Parses `cm lock list --format="{owner}|{path}"` lines; paths are workspace-relative or absolute. */
+	static TSharedPtr<const FSafeSaveLockIndex, ESPMode::ThreadSafe> ParsePlasticLocks(const FString& Output, const FString& WorkspaceRoot, const FString& CurrentUser);
+
+	/** Records a lock on an absolute filename; non-package files are ignored. Only while the index is being built. */
+	void Add(const FString& Filename, FSafeSaveFileLock&& Lock);
+
+	const FSafeSaveFileLock* Find(FName PackageName) const { return Entries.Find(PackageName); }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	TMap<FName, FSafeSaveFileLock> Entries;
+};
+
+using FSafeSaveLockIndexPtr = TSharedPtr<const FSafeSaveLockIndex, ESPMode::ThreadSafe>;
@@ -0,0 +1,185 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveLockTracker.h"
+
+#include "SafeSaveCommandRunner.h"
+#include "SafeSaveSettings.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Consecutive failed lock queries after which they stop for the session.
+	constexpr int32 MaxLockQueryFailures = 3;
+}
+
+FSafeSaveLockTracker::FSafeSaveLockTracker(const FSafeSaveCommandRunner& InRunner)
+	: Runner(InRunner)
+{
+}
+
+bool FSafeSaveLockTracker::BeginRefresh(const FSafeSaveSourceControlStatus& Status, uint32& OutPreviousChecksum)
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings || !Settings->bQueryLocks || bLocksUnavailable || bRefreshInFlight
+		|| !Status.bClientAvailable || !Status.bRepo || Status.RepoRoot.IsEmpty()
+		|| Status.Provider == ESafeSaveSourceControlProvider::None || !Status.EditorProviderName.IsEmpty())
+	{
+		// With the editor's provider, locks come from its cached states along with the status.
+		return false;
+	}
+
+	bRefreshInFlight = true;
+	LastRefreshSeconds = FPlatformTime::Seconds();
+	OutPreviousChecksum = LockOutputChecksum;
+	return true;
+}
+
+FSafeSaveLockTracker::FQueryResult FSafeSaveLockTracker::Query(ESafeSaveSourceControlProvider Provider, const FString& RepoRoot, uint32 PreviousChecksum) const
+{
+	FQueryResult Result;
+	Result.Checksum = PreviousChecksum;
+
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+	bool bVerified = false;
+
+	if (Provider == ESafeSaveSourceControlProvider::Git)
+	{
+		// --verify splits the list into ours/theirs, but needs server support; otherwise compare owner names.
+		bVerified = Runner.RunGit(TEXT("lfs locks --verify --json"), RepoRoot, StdOut, StdErr, ExitCode, true) && ExitCode == 0;
+		Result.bSuccess = bVerified;
+		if (!bVerified && !Runner.IsCancelled())
+		{
+			Result.bUnavailable = StdErr.Contains(TEXT("is not a git command"));
+			Result.bSuccess = !Result.bUnavailable && Runner.RunGit(TEXT("lfs locks --json"), RepoRoot, StdOut, StdErr, ExitCode, true) && ExitCode == 0;
+		}
+	}
+	else
+	{
+		// An explicit format, so the parser does not depend on the default column order.
+		Result.bSuccess = Runner.RunPlastic(TEXT("lock list --format=\"{owner}|{path}\""), RepoRoot, StdOut, StdErr, ExitCode, true) && ExitCode == 0;
+	}
+
+	if (Result.bSuccess)
+	{
+		Result.Checksum = FCrc::StrCrc32(*StdOut);
+		if (Result.Checksum != PreviousChecksum)
+		{
+			const FString CurrentUser = bVerified ? FString() : GetUserName(Provider, RepoRoot);
+			Result.Index = Provider == ESafeSaveSourceControlProvider::Git
+				? FSafeSaveLockIndex::ParseGitLfsLocks(StdOut, RepoRoot, CurrentUser)
+				: FSafeSaveLockIndex::ParsePlasticLocks(StdOut, RepoRoot, CurrentUser);
+			Result.bSuccess = Result.Index.IsValid();
+		}
+	}
+
+	Result.ErrorText = StdErr.TrimStartAndEnd();
+	return Result;
+}
+
+void FSafeSaveLockTracker::FinishRefresh(const FQueryResult& Result)
+{
+	bRefreshInFlight = false;
+	if (Result.bUnavailable)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[SafeSave] git-lfs is not installed; lock warnings are off for this session."));
+		bLocksUnavailable = true;
+		return;
+	}
+	if (!Result.bSuccess)
+	{
+		// Keep the last known locks. A repository without LFS locking answers with the same error every
+		// time, so after a few failures in a row the round-trips stop for this session.
+		UE_LOG(LogTemp, Verbose, TEXT("[SafeSave] Lock query failed: %s"), *Result.ErrorText);
+		if (++NumQueryFailures >= MaxLockQueryFailures)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SafeSave] Lock queries failed %d times in a row; lock warnings are off for this session. Last error: %s"), NumQueryFailures, *Result.ErrorText);
+			bLocksUnavailable = true;
+		}
+		return;
+	}
+
+	NumQueryFailures = 0;
+	LockOutputChecksum = Result.Checksum;
+	if (Result.Index.IsValid())
+	{
+		SetLockIndex(Result.Index);
+	}
+}
+
+void FSafeSaveLockTracker::SetLockIndex(const FSafeSaveLockIndexPtr& NewIndex)
+{
+	LockIndex = NewIndex;
+
+	// Forget warnings for packages that were unlocked or changed hands, so a new lock warns again.
+	for (auto It = WarnedLockOwners.CreateIterator(); It; ++It)
+	{
+		const FSafeSaveFileLock* Lock = NewIndex.IsValid() ? NewIndex->Find(It.Key()) : nullptr;
+		if (!Lock || Lock->Owner != It.Value())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FSafeSaveLockTracker::TakeUnwarnedOwner(FName PackageName, FString& OutOwner)
+{
+	const FSafeSaveFileLock* Lock = Find(PackageName);
+	if (!Lock || Lock->bOwnedByCurrentUser)
+	{
+		return false;
+	}
+
+	const FString* WarnedOwner = WarnedLockOwners.Find(PackageName);
+	if (WarnedOwner && *WarnedOwner == Lock->Owner)
+	{
+		return false;
+	}
+	WarnedLockOwners.Add(PackageName, Lock->Owner);
+
+	OutOwner = Lock->Owner;
+	return true;
+}
+
+void FSafeSaveLockTracker::ResetUserName() const
+{
+	FScopeLock Lock(&UserNameLock);
+	UserNameProvider = ESafeSaveSourceControlProvider::None;
+	UserNameRepoRoot.Reset();
+}
+
+FString FSafeSaveLockTracker::GetUserName(ESafeSaveSourceControlProvider Provider, const FString& RepoRoot) const
+{
+	{
+		FScopeLock Lock(&UserNameLock);
+		if (UserNameProvider == Provider && UserNameRepoRoot == RepoRoot)
+		{
+			return UserName;
+		}
+	}
+
+	// Per repository, as user.name can be set repository-locally.
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+	const bool bResolved = Provider == ESafeSaveSourceControlProvider::Git
+		? Runner.RunGit(TEXT("config user.name"), RepoRoot, StdOut, StdErr, ExitCode)
+		: Runner.RunPlastic(TEXT("whoami"), RepoRoot, StdOut, StdErr, ExitCode);
+
+	const FString ResolvedName = bResolved && ExitCode == 0 ? StdOut.TrimStartAndEnd() : FString();
+	if (ResolvedName.IsEmpty())
+	{
+		// Not cached, so a login or a user.name set later is picked up by the next lock refresh.
+		return ResolvedName;
+	}
+
+	FScopeLock Lock(&UserNameLock);
+	UserName = ResolvedName;
+	UserNameRepoRoot = RepoRoot;
+	UserNameProvider = Provider;
+	return ResolvedName;
+}
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SafeSaveLockIndex.h"
+#include "SafeSaveSourceControlStatus.h"
+
+class FSafeSaveCommandRunner;
+
+/**
+ * Keeps the repository's lock list from `git lfs locks` or `cm lock list` and remembers which locks were
+ * already warned about. Refreshes are started and finished on the game thread; the query itself runs on the
+ * status worker.
+ */
+class FSafeSaveLockTracker
+{
+public:
+	/** Outcome of one lock query, handed from the worker to FinishRefresh. */
+	struct FQueryResult
+	{
+		bool bSuccess = false;
+		/** The lock command does not exist (no git-lfs). */
+		bool bUnavailable = false;
+		uint32 Checksum = 0;
+		/** Null when the lock list did not change since the last query. */
+		FSafeSaveLockIndexPtr Index;
+		FString ErrorText;
+	};
+
+	explicit FSafeSaveLockTracker(const FSafeSaveCommandRunner& InRunner);
+
+	/**
+	 * Marks a refresh for Status as in flight, or returns false when locks are off, unavailable or already being
+	 * queried, or Status has no repository. OutPreviousChecksum goes to Query. Game thread.
+	 */
+	bool BeginRefresh(const FSafeSaveSourceControlStatus& Status, uint32& OutPreviousChecksum);
+	/** Runs the lock command for RepoRoot; an output matching PreviousChecksum is not parsed again. Worker thread. */
+	FQueryResult Query(ESafeSaveSourceControlProvider Provider, const FString& RepoRoot, uint32 PreviousChecksum) const;
+	/** Publishes a finished query; failures keep the last known locks. Game thread. */
+	void FinishRefresh(const FQueryResult& Result);
+	/** The refresh started by BeginRefresh could not be queued. */
+	void CancelRefresh() { bRefreshInFlight = false; }
+
+	double GetLastRefreshSeconds() const { return LastRefreshSeconds; }
+	/** Counts the next periodic refresh from NowSeconds. */
+	void SetLastRefreshSeconds(double NowSeconds) { LastRefreshSeconds = NowSeconds; }
+
+	/** Replaces the lock list, e.g. with the one the editor's provider reported. Game thread. */
+	void SetLockIndex(const FSafeSaveLockIndexPtr& NewIndex);
+	const FSafeSaveFileLock* Find(FName PackageName) const { return LockIndex.IsValid() ? LockIndex->Find(PackageName) : nullptr; }
+
+	/**
+	 * Owner of a lock someone else holds on PackageName, when no warning was shown for that owner yet; the
+	 * owner is then recorded as warned. Game thread.
+	 */
+	bool TakeUnwarnedOwner(FName PackageName, FString& OutOwner);
+
+	/** Resolves the user name again with the next lock query. Any thread. */
+	void ResetUserName() const;
+
+private:
+	/** User name that lock owners are compared with when the server does not say which locks are ours. */
+	FString GetUserName(ESafeSaveSourceControlProvider Provider, const FString& RepoRoot) const;
+
+	const FSafeSaveCommandRunner& Runner;
+
+	FSafeSaveLockIndexPtr LockIndex;
+	/** Checksum of the last lock command output; an unchanged list is not parsed again. */
+	uint32 LockOutputChecksum = 0;
+	double LastRefreshSeconds = 0.0;
+	bool bRefreshInFlight = false;
+	/** Set when the lock command does not exist (no git-lfs) or keeps failing; not retried this session. */
+	bool bLocksUnavailable = false;
+	int32 NumQueryFailures = 0;
+	/** Owner each locked package was last warned about. */
+	TMap<FName, FString> WarnedLockOwners;
+
+	/** User name lock owners are compared with, for one provider and repository; guarded by UserNameLock. */
+	mutable FString UserName;
+	mutable FString UserNameRepoRoot;
+	mutable ESafeSaveSourceControlProvider UserNameProvider = ESafeSaveSourceControlProvider::None;
+	mutable FCriticalSection UserNameLock;
+};
@@ -1,8 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SafeSaveModule.h"
+#include "SafeSaveDemo.h"
 #include "SafeSaveStyle.h"
 #include "SafeSaveSettings.h"
+#include "SafeSaveStatusService.h"
 #include "SSafeSaveToolbar.h"
 
 #include "ISettingsModule.h"
@@ -15,6 +17,11 @@ void FSafeSaveModule::StartupModule()
 	FSafeSaveStyle::Initialize();
 	FSafeSaveStyle::ReloadTextures();
 
+	StatusService = MakeShared<FSafeSaveStatusService>();
+	StatusService->Initialize();
+
+	FSafeSaveDemo::RegisterCommands();
+
 	if (UToolMenus::Get())
 	{
 		UToolMenus::RegisterStartupCallback(
@@ -40,6 +47,14 @@ void FSafeSaveModule::ShutdownModule()
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
 
+	FSafeSaveDemo::UnregisterCommands();
+
+	if (StatusService.IsValid())
+	{
+		StatusService->Shutdown();
+		StatusService.Reset();
+	}
+
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
 		SettingsModule->UnregisterSettings("Editor", "Plugins", "SafeSave");
@@ -48,6 +63,48 @@ void FSafeSaveModule::ShutdownModule()
 	FSafeSaveStyle::Shutdown();
 }
 
+ESafeSaveFileStatus FSafeSaveModule::GetPackageStatus(FName PackageName) const
+{
+	return StatusService.IsValid() ? StatusService->GetPackageStatus(PackageName) : ESafeSaveFileStatus::None;
+}
+
+bool FSafeSaveModule::GetPackageLock(FName PackageName, FString& OutOwner, bool& bOutOwnedByCurrentUser) const
+{
+	const FSafeSaveFileLock* Lock = StatusService.IsValid() ? StatusService->FindPackageLock(PackageName) : nullptr;
+	if (!Lock)
+	{
+		return false;
+	}
+
+	OutOwner = Lock->Owner;
+	bOutOwnedByCurrentUser = Lock->bOwnedByCurrentUser;
+	return true;
+}
+
+FSafeSaveStatusSnapshotRef FSafeSaveModule::GetStatusSnapshot() const
+{
+	return StatusService.IsValid() ? StatusService->GetPublishedSnapshot() : MakeShared<FSafeSaveStatusSnapshot, ESPMode::ThreadSafe>();
+}
+
+FOnSafeSaveStatusChanged& FSafeSaveModule::OnStatusChanged()
+{
+	check(StatusService.IsValid());
+	return StatusService->OnStatusChanged();
+}
+
+void FSafeSaveModule::RequestStatusRefresh()
+{
+	if (StatusService.IsValid())
+	{
+		StatusService->RequestCoalescedRefresh();
+	}
+}
+
+TArray<FString> FSafeSaveModule::GetFailedSafetyChecks() const
+{
+	return StatusService.IsValid() ? StatusService->GetFailedSafetyChecks() : TArray<FString>();
+}
+
 void FSafeSaveModule::RegisterMenus()
 {
 	FToolMenuOwnerScoped OwnerScoped(this);
@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSavePackageFilter.h"
+
+#include "SafeSaveSettings.h"
+
+#include "String/Find.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	FString NormalizePrefix(const FString& InPrefix)
+	{
+		FString Prefix = InPrefix;
+		Prefix.TrimStartAndEndInline();
+		Prefix.ReplaceCharInline(TEXT('\\'), TEXT('/'));
+		if (!Prefix.IsEmpty() && !Prefix.StartsWith(TEXT("/")))
+		{
+			Prefix.InsertAt(0, TEXT('/'));
+		}
+		return Prefix.ToLower();
+	}
+
+	uint32 HashRules(uint32 Hash, const TArray<FString>& Rules)
+	{
+		for (const FString& Rule : Rules)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Rule.ToLower()));
+		}
+		return HashCombineFast(Hash, Rules.Num());
+	}
+}
+
+TSharedRef<const FSafeSavePackageFilter> FSafeSavePackageFilter::Create(const USafeSaveSettings* Settings)
+{
+	if (!Settings)
+	{
+		return MakeShared<FSafeSavePackageFilter>(TArray<FString>(), TArray<FString>(), TArray<FString>());
+	}
+
+	return MakeShared<FSafeSavePackageFilter>(Settings->UnsavedIncludePaths, Settings->UnsavedExcludePaths, Settings->UnsavedExcludeNameMarkers);
+}
+
+FSafeSavePackageFilter::FSafeSavePackageFilter(const TArray<FString>& IncludePrefixes, const TArray<FString>& ExcludePrefixes, const TArray<FString>& ExcludeMarkers)
+{
+	Nodes.AddDefaulted();
+
+	bool bHasIncludes = false;
+	for (const FString& Prefix : IncludePrefixes)
+	{
+		const FString Normalized = NormalizePrefix(Prefix);
+		if (!Normalized.IsEmpty())
+		{
+			AddPrefix(Normalized, EVerdict::Include);
+			bHasIncludes = true;
+		}
+	}
+	for (const FString& Prefix : ExcludePrefixes)
+	{
+		const FString Normalized = NormalizePrefix(Prefix);
+		if (!Normalized.IsEmpty())
+		{
+			AddPrefix(Normalized, EVerdict::Exclude);
+		}
+	}
+	for (const FString& Marker : ExcludeMarkers)
+	{
+		const FString Trimmed = Marker.TrimStartAndEnd();
+		if (!Trimmed.IsEmpty())
+		{
+			Markers.Add(Trimmed);
+		}
+	}
+
+	DefaultVerdict = bHasIncludes ? EVerdict::Exclude : EVerdict::Include;
+	RulesHash = HashRules(HashRules(HashRules(0, IncludePrefixes), ExcludePrefixes), ExcludeMarkers);
+}
+
+bool FSafeSavePackageFilter::ShouldCount(FStringView PackageName) const
+{
+	EVerdict Verdict = DefaultVerdict;
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : PackageName)
+	{
+		NodeIndex = FindChild(NodeIndex, FChar::ToLower(Char));
+		if (NodeIndex == INDEX_NONE)
+		{
+			break;
+		}
+		if (Nodes[NodeIndex].Verdict != EVerdict::None)
+		{
+			Verdict = Nodes[NodeIndex].Verdict;
+		}
+	}
+
+	if (Verdict == EVerdict::Exclude)
+	{
+		return false;
+	}
+
+	for (const FString& Marker : Markers)
+	{
+		if (UE::String::FindFirst(PackageName, Marker, ESearchCase::IgnoreCase) != INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FSafeSavePackageFilter::ShouldCount(const UPackage* Package) const
+{
+	if (!Package)
+	{
+		return false;
+	}
+
+	TStringBuilder<FName::StringBufferSize> PackageName;
+	Package->GetFName().ToString(PackageName);
+	return ShouldCount(PackageName.ToView());
+}
+
+void FSafeSavePackageFilter::AddPrefix(const FString& Prefix, EVerdict Verdict)
+{
+	int32 NodeIndex = 0;
+	for (const TCHAR Char : Prefix)
+	{
+		int32 ChildIndex = FindChild(NodeIndex, Char);
+		if (ChildIndex == INDEX_NONE)
+		{
+			ChildIndex = Nodes.AddDefaulted();
+
+			auto& Children = Nodes[NodeIndex].Children;
+			int32 InsertAt = 0;
+			while (InsertAt < Children.Num() && Children[InsertAt].Key < Char)
+			{
+				++InsertAt;
+			}
+			Children.Insert(TPair<TCHAR, int32>(Char, ChildIndex), InsertAt);
+		}
+		NodeIndex = ChildIndex;
+	}
+
+	// The same prefix listed as both include and exclude: exclude wins.
+	if (Nodes[NodeIndex].Verdict != EVerdict::Exclude)
+	{
+		Nodes[NodeIndex].Verdict = Verdict;
+	}
+}
+
+int32 FSafeSavePackageFilter::FindChild(int32 NodeIndex, TCHAR Char) const
+{
+	for (const TPair<TCHAR, int32>& Child : Nodes[NodeIndex].Children)
+	{
+		if (Child.Key == Char)
+		{
+			return Child.Value;
+		}
+		if (Child.Key > Char)
+		{
+			break;
+		}
+	}
+	return INDEX_NONE;
+}
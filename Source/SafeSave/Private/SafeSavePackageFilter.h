@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+class USafeSaveSettings;
+
+/**
+ * Decides which dirty packages count as unsaved work. Include and exclude path prefixes (e.g. /Temp/,
+ * /Game/Developers/) are compiled once into a case-insensitive prefix trie so a lookup costs one walk over
+ * the package name, independent of the number of rules; the longest matching prefix wins. Packages whose
+ * name contains one of the marker strings (World Partition InstanceOf_ packages) are always ignored.
+ */
+class FSafeSavePackageFilter
+{
+public:
+	/** Compiles the rules from the SafeSave settings. */
+	static TSharedRef<const FSafeSavePackageFilter> Create(const USafeSaveSettings* Settings);
+
+	FSafeSavePackageFilter(const TArray<FString>& IncludePrefixes, const TArray<FString>& ExcludePrefixes, const TArray<FString>& ExcludeMarkers);
+
+	/** True if a dirty package of this long name (e.g. /Game/Maps/Entry) should be reported. */
+	bool ShouldCount(FStringView PackageName) const;
+	bool ShouldCount(const UPackage* Package) const;
+
+	/** True if both filters were compiled from the same rules. */
+	bool HasSameRules(const FSafeSavePackageFilter& Other) const { return RulesHash == Other.RulesHash; }
+
+private:
+	enum class EVerdict : uint8
+	{
+		None,
+		Include,
+		Exclude
+	};
+
+	struct FNode
+	{
+		/** Sorted by character; package names use a small alphabet, so a linear scan beats hashing. */
+		TArray<TPair<TCHAR, int32>, TInlineAllocator<2>> Children;
+		EVerdict Verdict = EVerdict::None;
+	};
+
+	void AddPrefix(const FString& Prefix, EVerdict Verdict);
+	int32 FindChild(int32 NodeIndex, TCHAR Char) const;
+
+	TArray<FNode> Nodes;
+	TArray<FString> Markers;
+	/** Verdict for names no prefix matches: include, unless include rules exist. */
+	EVerdict DefaultVerdict = EVerdict::Include;
+	uint32 RulesHash = 0;
+};
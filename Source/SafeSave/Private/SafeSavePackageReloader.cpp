@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSavePackageReloader.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "PackageTools.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	const TCHAR* PackageExtensions[] = { TEXT(".uasset"), TEXT(".umap") };
+
+	bool IsPackageFile(const FString& Path)
+	{
+		for (const TCHAR* Extension : PackageExtensions)
+		{
+			if (Path.EndsWith(Extension, ESearchCase::IgnoreCase))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+void FSafeSavePackageReloader::ParseGitDiffNames(const FString& Output, const FString& RepoRoot, TArray<FString>& OutFilenames)
+{
+	TArray<FString> Lines;
+	Output.ParseIntoArrayLines(Lines, true);
+	for (FString& Line : Lines)
+	{
+		// Paths git had to escape are quoted; with core.quotepath off that is only control characters and quotes.
+		Line.TrimStartAndEndInline();
+		if (Line.Len() >= 2 && Line.StartsWith(TEXT("\"")) && Line.EndsWith(TEXT("\"")))
+		{
+			Line = Line.Mid(1, Line.Len() - 2);
+		}
+
+		if (IsPackageFile(Line))
+		{
+			OutFilenames.Add(FPaths::ConvertRelativePathToFull(RepoRoot, Line));
+		}
+	}
+}
+
+void FSafeSavePackageReloader::ParsePlasticUpdateOutput(const FString& Output, const FString& WorkspaceRoot, TArray<FString>& OutFilenames)
+{
+	FString Root = FPaths::ConvertRelativePathToFull(WorkspaceRoot);
+	FPaths::NormalizeDirectoryName(Root);
+	if (Root.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<FString> Lines;
+	Output.ParseIntoArrayLines(Lines, true);
+	for (FString& Line : Lines)
+	{
+		// Progress lines wrap the path in text ("Downloading file c:\ws\Content\A.uasset (1.2 MB)"), so the
+		// path is cut out between the workspace root and the first package extension after it.
+		FPaths::NormalizeFilename(Line);
+		const int32 Start = Line.Find(Root, ESearchCase::IgnoreCase);
+		if (Start == INDEX_NONE)
+		{
+			continue;
+		}
+
+		int32 End = INDEX_NONE;
+		for (const TCHAR* Extension : PackageExtensions)
+		{
+			const int32 Found = Line.Find(Extension, ESearchCase::IgnoreCase, ESearchDir::FromStart, Start);
+			if (Found != INDEX_NONE && (End == INDEX_NONE || Found + FCString::Strlen(Extension) < End))
+			{
+				End = Found + FCString::Strlen(Extension);
+			}
+		}
+
+		if (End != INDEX_NONE)
+		{
+			OutFilenames.Add(Line.Mid(Start, End - Start));
+		}
+	}
+}
+
+FSafeSavePackageReloader::FResult FSafeSavePackageReloader::ReloadChangedFiles(const TArray<FString>& Filenames)
+{
+	FResult Result;
+
+	TArray<FString> PackageFiles;
+	TArray<UPackage*> PackagesToReload;
+	TSet<FString> Seen;
+	for (const FString& Filename : Filenames)
+	{
+		FString PackageName;
+		if (!IsPackageFile(Filename) || Seen.Contains(Filename)
+			|| !FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName))
+		{
+			continue;
+		}
+		Seen.Add(Filename);
+		PackageFiles.Add(Filename);
+
+		// Deleted files are only rescanned, which drops them from the registry; their loaded package is not touched.
+		UPackage* Package = FindPackage(nullptr, *PackageName);
+		if (!Package || !FPaths::FileExists(Filename))
+		{
+			continue;
+		}
+
+		if (Package->IsDirty())
+		{
+			++Result.NumSkippedDirty;
+			continue;
+		}
+		PackagesToReload.Add(Package);
+	}
+
+	if (PackageFiles.Num() == 0)
+	{
+		return Result;
+	}
+
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->ScanModifiedAssetFiles(PackageFiles);
+		Result.NumRescanned = PackageFiles.Num();
+	}
+
+	if (PackagesToReload.Num() > 0)
+	{
+		FText ErrorMessage;
+		UPackageTools::ReloadPackages(PackagesToReload, ErrorMessage, EReloadPackagesInteractionMode::AssumePositive);
+		if (!ErrorMessage.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SafeSave] Reloading changed packages: %s"), *ErrorMessage.ToString());
+		}
+		Result.NumReloaded = PackagesToReload.Num();
+	}
+
+	return Result;
+}
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Brings the editor up to date with the files a pull or update changed, instead of leaving the asset registry
+ * and loaded packages to notice on their own: only those files are rescanned and only loaded packages among
+ * them are reloaded, so recovery time follows the size of the change rather than of the project.
+ */
+class FSafeSavePackageReloader
+{
+public:
+	struct FResult
+	{
+		/** Package files handed to the asset registry for a rescan. */
+		int32 NumRescanned = 0;
+		/** Loaded packages reloaded from disk. */
+		int32 NumReloaded = 0;
+		/** Loaded packages left alone because they have unsaved changes. */
+		int32 NumSkippedDirty = 0;
+	};
+
+	/** Adds the absolute filenames from `git diff --name-only` output, whose paths are relative to RepoRoot. */
+	static void ParseGitDiffNames(const FString& Output, const FString& RepoRoot, TArray<FString>& OutFilenames);
+
+	/**
+	 * Adds the package files named in `cm update` output. cm prints one line per downloaded or deleted item
+	 * with its path inside the workspace; lines without a package path under WorkspaceRoot are ignored.
+	 */
+	static void ParsePlasticUpdateOutput(const FString& Output, const FString& WorkspaceRoot, TArray<FString>& OutFilenames);
+
+	/** Rescans the package files among Filenames and reloads the ones that are loaded and not dirty. Game thread only. */
+	static FResult ReloadChangedFiles(const TArray<FString>& Filenames);
+};
@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSavePlasticShell.h"
+
+#include "SafeSaveStats.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	const FAnsiStringView CommandResultPrefix("CommandResult ");
+
+	// Total time one command may take from being sent, output or not; a status query on a large workspace can take
+	// a while, but a session still without a result after this long is considered hung.
+	constexpr double DefaultCommandTimeoutSeconds = 60.0;
+	constexpr float ExitGraceSeconds = 0.5f;
+
+	FString BytesToString(const uint8* Data, int32 Num)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Num);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	/** Finds a complete "CommandResult <code>" line; returns its start offset and the offset just past its newline. */
+	bool FindCommandResult(const TArray<uint8>& Buffer, int32& OutLineStart, int32& OutLineEnd, int32& OutExitCode)
+	{
+		int32 LineStart = 0;
+		for (int32 Index = 0; Index < Buffer.Num(); ++Index)
+		{
+			if (Buffer[Index] != '\n')
+			{
+				continue;
+			}
+
+			FAnsiStringView Line(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + LineStart), Index - LineStart);
+			if (Line.StartsWith(CommandResultPrefix, ESearchCase::CaseSensitive))
+			{
+				Line.RightChopInline(CommandResultPrefix.Len());
+				Line.TrimStartAndEndInline();
+
+				const bool bNegative = Line.StartsWith('-');
+				int32 Code = 0;
+				for (const ANSICHAR Char : Line.RightChop(bNegative ? 1 : 0))
+				{
+					if (Char < '0' || Char > '9')
+					{
+						break;
+					}
+					Code = Code * 10 + (Char - '0');
+				}
+
+				OutLineStart = LineStart;
+				OutLineEnd = Index + 1;
+				OutExitCode = bNegative ? -Code : Code;
+				return true;
+			}
+
+			LineStart = Index + 1;
+		}
+
+		return false;
+	}
+}
+
+FSafeSavePlasticShell::FSafeSavePlasticShell(const FString& InExecutable)
+	: Executable(InExecutable)
+{
+}
+
+FSafeSavePlasticShell::~FSafeSavePlasticShell()
+{
+	Stop();
+}
+
+bool FSafeSavePlasticShell::Execute(const FString& Command, const FString& WorkingDir, FString& OutOutput, int32& OutExitCode, const FSafeSaveProcess::FLimits& Limits)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_PlasticShellCommand, FSafeSavePlasticShell::Execute);
+
+	FScopeLock ScopeLock(&Lock);
+	OutOutput.Reset();
+	OutExitCode = -1;
+
+	// One retry: a session that died since the last command (cm upgraded, server restarted) is replaced transparently.
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		if (!IsRunning() || SessionDir != WorkingDir)
+		{
+			StopLocked();
+			if (!Start(WorkingDir))
+			{
+				return false;
+			}
+		}
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		bool bGaveUp = false;
+		const bool bAnswered = SendCommand(Command) && ReadCommandResult(OutOutput, OutExitCode, Limits, bGaveUp);
+		FSafeSaveStats::RecordProcess(FPlatformTime::Seconds() - StartSeconds, false);
+		if (bAnswered)
+		{
+			return true;
+		}
+
+		// A hung or cancelled session is killed; retrying would only wait out the same timeout again.
+		StopLocked();
+		if (bGaveUp)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SafeSave] cm shell stopped answering `%s` and was terminated."), *Command);
+			break;
+		}
+	}
+
+	return false;
+}
+
+void FSafeSavePlasticShell::Stop()
+{
+	FScopeLock ScopeLock(&Lock);
+	StopLocked();
+}
+
+bool FSafeSavePlasticShell::Start(const FString& WorkingDir)
+{
+	if (!FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite))
+	{
+		return false;
+	}
+	if (!FPlatformProcess::CreatePipe(StdInRead, StdInWrite, true))
+	{
+		FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+		StdOutRead = StdOutWrite = nullptr;
+		return false;
+	}
+
+	Process = FPlatformProcess::CreateProc(
+		*Executable,
+		TEXT("shell --encoding=UTF-8"),
+		false,
+		true,
+		true,
+		nullptr,
+		0,
+		WorkingDir.IsEmpty() ? nullptr : *WorkingDir,
+		StdOutWrite,
+		StdInRead
+	);
+
+	if (!Process.IsValid())
+	{
+		StopLocked();
+		return false;
+	}
+
+	FSafeSaveStats::RecordProcess(0.0, true);
+	SessionDir = WorkingDir;
+	return true;
+}
+
+bool FSafeSavePlasticShell::IsRunning()
+{
+	return Process.IsValid() && FPlatformProcess::IsProcRunning(Process);
+}
+
+bool FSafeSavePlasticShell::SendCommand(const FString& Command)
+{
+	const FTCHARToUTF8 Converted(*(Command + TEXT("\n")));
+	int32 Written = 0;
+	return FPlatformProcess::WritePipe(StdInWrite, reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length(), &Written)
+		&& Written == Converted.Length();
+}
+
+bool FSafeSavePlasticShell::ReadCommandResult(FString& OutOutput, int32& OutExitCode, const FSafeSaveProcess::FLimits& Limits, bool& bOutGaveUp)
+{
+	const double Deadline = FPlatformTime::Seconds() + (Limits.TimeoutSeconds > 0.0 ? Limits.TimeoutSeconds : DefaultCommandTimeoutSeconds);
+	TArray<uint8> Chunk;
+
+	for (;;)
+	{
+		int32 LineStart = 0;
+		int32 LineEnd = 0;
+		if (FindCommandResult(Buffer, LineStart, LineEnd, OutExitCode))
+		{
+			OutOutput = BytesToString(Buffer.GetData(), LineStart);
+			OutOutput.TrimEndInline();
+			Buffer.RemoveAt(0, LineEnd, EAllowShrinking::No);
+			return true;
+		}
+
+		if (FPlatformProcess::ReadPipeToArray(StdOutRead, Chunk) && Chunk.Num() > 0)
+		{
+			Buffer.Append(Chunk);
+			continue;
+		}
+
+		if (!FPlatformProcess::IsProcRunning(Process))
+		{
+			return false;
+		}
+		if (FPlatformTime::Seconds() > Deadline || (Limits.CancelFlag && Limits.CancelFlag->Load()))
+		{
+			bOutGaveUp = true;
+			return false;
+		}
+
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+void FSafeSavePlasticShell::StopLocked()
+{
+	if (Process.IsValid())
+	{
+		if (FPlatformProcess::IsProcRunning(Process))
+		{
+			SendCommand(TEXT("exit"));
+
+			const double Deadline = FPlatformTime::Seconds() + ExitGraceSeconds;
+			while (FPlatformProcess::IsProcRunning(Process) && FPlatformTime::Seconds() < Deadline)
+			{
+				FPlatformProcess::Sleep(0.01f);
+			}
+			if (FPlatformProcess::IsProcRunning(Process))
+			{
+				FPlatformProcess::TerminateProc(Process, true);
+			}
+		}
+		FPlatformProcess::CloseProc(Process);
+		Process = FProcHandle();
+	}
+
+	if (StdOutRead || StdOutWrite)
+	{
+		FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+	}
+	if (StdInRead || StdInWrite)
+	{
+		FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+	}
+	StdOutRead = StdOutWrite = StdInRead = StdInWrite = nullptr;
+
+	Buffer.Reset();
+	SessionDir.Reset();
+}
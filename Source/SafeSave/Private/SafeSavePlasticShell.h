@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "SafeSaveProcess.h"
+
+/**
+ * A long-lived `cm shell` session. Commands are written to its stdin one per line and each answer is read
+ * back up to the "CommandResult <code>" line cm prints when the command finishes, so a status refresh pays
+ * for one cm startup per editor session instead of one per command.
+ */
+class FSafeSavePlasticShell
+{
+public:
+	explicit FSafeSavePlasticShell(const FString& InExecutable);
+	~FSafeSavePlasticShell();
+
+	/**
+	 * Runs a cm command (without the leading "cm") in a session rooted at WorkingDir, starting or restarting
+	 * the session as needed. Returns false if no session could be started or it stopped answering; a session
+	 * that does not answer within Limits (or is cancelled) is terminated.
+	 * cm shell reports errors on stdout, so OutOutput carries both streams.
+	 */
+	bool Execute(const FString& Command, const FString& WorkingDir, FString& OutOutput, int32& OutExitCode, const FSafeSaveProcess::FLimits& Limits = FSafeSaveProcess::FLimits());
+
+	/** Ends the session; the next Execute starts a fresh one. */
+	void Stop();
+
+private:
+	bool Start(const FString& WorkingDir);
+	bool IsRunning();
+	bool SendCommand(const FString& Command);
+	/** bOutGaveUp is set when the answer did not arrive within Limits, as opposed to the session exiting. */
+	bool ReadCommandResult(FString& OutOutput, int32& OutExitCode, const FSafeSaveProcess::FLimits& Limits, bool& bOutGaveUp);
+	void StopLocked();
+
+	FString Executable;
+	FString SessionDir;
+	FProcHandle Process;
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdInRead = nullptr;
+	void* StdInWrite = nullptr;
+	/** Output read past the end of the previous answer. */
+	TArray<uint8> Buffer;
+	FCriticalSection Lock;
+};
@@ -0,0 +1,417 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSavePlasticStatusQuery.h"
+
+#include "SafeSaveCommandRunner.h"
+#include "SafeSaveDetectionCache.h"
+#include "SafeSavePlasticShell.h"
+#include "SafeSaveSettings.h"
+#include "SafeSaveSourceControlStatus.h"
+#include "SafeSaveStats.h"
+
+#include "Internationalization/Regex.h"
+
+namespace
+{
+	const FString PlasticFieldSeparator = TEXT("|");
+	const FString PlasticLineStart = TEXT("@@SAFE@@");
+	const FString PlasticLineEnd = TEXT("##SAFE##");
+
+	bool IsPlasticAuthError(const FString& Text)
+	{
+		const FString Lower = Text.ToLower();
+		return Lower.Contains(TEXT("login"))
+			|| Lower.Contains(TEXT("log in"))
+			|| Lower.Contains(TEXT("authentication"))
+			|| Lower.Contains(TEXT("credential"))
+			|| Lower.Contains(TEXT("unauthorized"))
+			|| Lower.Contains(TEXT("not authorized"))
+			|| Lower.Contains(TEXT("access denied"))
+			|| Lower.Contains(TEXT("token"))
+			|| Lower.Contains(TEXT("expired"));
+	}
+}
+
+FSafeSavePlasticStatusQuery::FSafeSavePlasticStatusQuery(const FSafeSaveCommandRunner& InRunner, FSafeSaveDetectionCache& InDetectionCache)
+	: Runner(InRunner)
+	, DetectionCache(InDetectionCache)
+{
+}
+
+FSafeSavePlasticStatusQuery::~FSafeSavePlasticStatusQuery() = default;
+
+void FSafeSavePlasticStatusQuery::StartShell()
+{
+	if (!PlasticShell.IsValid())
+	{
+		PlasticShell = MakeUnique<FSafeSavePlasticShell>(FSafeSaveCommandRunner::GetPlasticExecutable());
+	}
+}
+
+void FSafeSavePlasticStatusQuery::StopShell()
+{
+	if (PlasticShell.IsValid())
+	{
+		PlasticShell->Stop();
+	}
+}
+
+bool FSafeSavePlasticStatusQuery::Query(const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_PlasticStatus, FSafeSavePlasticStatusQuery::Query);
+
+	OutStatus = FSafeSaveSourceControlStatus();
+	OutStatus.Provider = ESafeSaveSourceControlProvider::Plastic;
+
+	FString StdOut;
+	FString StdErr;
+	int32 ExitCode = 0;
+
+	FSafeSaveDetectionCache::FDetection Detection;
+	const bool bFromCache = DetectionCache.Get(ESafeSaveSourceControlProvider::Plastic, ProjectDir, Detection);
+
+	if (bFromCache)
+	{
+		// The branch is recovered from the status header below, so workspaceinfo is skipped as well.
+		OutStatus.bClientAvailable = true;
+		OutStatus.bRepo = true;
+		OutStatus.RepoRoot = Detection.RepoRoot;
+		OutStatus.WorkspaceName = Detection.WorkspaceName;
+	}
+	else
+	{
+		// A one-off cm: the persistent session is started in the workspace root found here, so it is not
+		// started once in ProjectDir and then again in the root by the queries that follow.
+		const FString WorkspaceArgs = FString::Printf(TEXT("getworkspacefrompath \"%s\" --format=\"{wkname}|{wkpath}\""), *ProjectDir);
+		const bool bPlasticLaunched = Runner.RunPlastic(WorkspaceArgs, ProjectDir, StdOut, StdErr, ExitCode);
+
+		if (!bPlasticLaunched)
+		{
+			OutStatus.bClientAvailable = false;
+			OutError = TEXT("Plastic SCM CLI not found.");
+			OutStatus.LastError = OutError;
+			return false;
+		}
+
+		OutStatus.bClientAvailable = true;
+
+		if (ExitCode != 0 || StdOut.IsEmpty())
+		{
+			OutStatus.bRepo = false;
+			const FString Combined = (StdErr + TEXT("\n") + StdOut).TrimStartAndEnd();
+			if (IsPlasticAuthError(Combined))
+			{
+				OutStatus.bAuthRequired = true;
+				OutError = TEXT("Plastic SCM login required.");
+				OutStatus.LastError = Combined;
+			}
+			else
+			{
+				OutError = StdErr.TrimStartAndEnd();
+				OutStatus.LastError = OutError;
+			}
+			return false;
+		}
+
+		FString WorkspaceName;
+		FString WorkspaceRoot;
+		{
+			const FString Trimmed = StdOut.TrimStartAndEnd();
+			TArray<FString> Parts;
+			Trimmed.ParseIntoArray(Parts, TEXT("|"), true);
+			if (Parts.Num() >= 2)
+			{
+				WorkspaceName = Parts[0].TrimStartAndEnd();
+				WorkspaceRoot = Parts[1].TrimStartAndEnd();
+			}
+		}
+
+		if (WorkspaceRoot.IsEmpty())
+		{
+			OutStatus.bRepo = false;
+			OutError = TEXT("Plastic SCM workspace root not found.");
+			OutStatus.LastError = OutError;
+			return false;
+		}
+
+		OutStatus.bRepo = true;
+		OutStatus.RepoRoot = WorkspaceRoot;
+		OutStatus.WorkspaceName = WorkspaceName;
+
+		Detection.Provider = ESafeSaveSourceControlProvider::Plastic;
+		Detection.ProjectDir = ProjectDir;
+		Detection.RepoRoot = WorkspaceRoot;
+		Detection.WorkspaceName = WorkspaceName;
+		DetectionCache.Store(Detection);
+
+		StdOut.Reset();
+		StdErr.Reset();
+		ExitCode = 0;
+
+		const FString WorkspaceInfoArgs = FString::Printf(TEXT("workspaceinfo \"%s\""), *OutStatus.RepoRoot);
+		const bool bInfoOk = RunQuery(WorkspaceInfoArgs, OutStatus.RepoRoot, StdOut, StdErr, ExitCode);
+		if (bInfoOk && ExitCode == 0)
+		{
+			TArray<FString> InfoLines;
+			StdOut.ParseIntoArrayLines(InfoLines, true);
+			for (const FString& Line : InfoLines)
+			{
+				const FString Trimmed = Line.TrimStartAndEnd();
+				int32 SplitIndex = INDEX_NONE;
+				if (Trimmed.StartsWith(TEXT("Branch")) && (Trimmed.FindChar(TEXT(':'), SplitIndex) || Trimmed.FindChar(TEXT('='), SplitIndex)))
+				{
+					OutStatus.Branch = Trimmed.Mid(SplitIndex + 1).TrimStartAndEnd();
+					break;
+				}
+			}
+		}
+		else
+		{
+			const FString Combined = (StdErr + TEXT("\n") + StdOut).TrimStartAndEnd();
+			if (IsPlasticAuthError(Combined))
+			{
+				OutStatus.bAuthRequired = true;
+				OutStatus.LastError = Combined;
+				OutError = TEXT("Plastic SCM login required.");
+				return true;
+			}
+		}
+	}
+
+	StdOut.Reset();
+	StdErr.Reset();
+	ExitCode = 0;
+
+	const bool bHeaderOk = RunQuery(TEXT("status --header --head"), OutStatus.RepoRoot, StdOut, StdErr, ExitCode);
+	if (bHeaderOk && ExitCode == 0)
+	{
+		int32 CurrentChangeset = INDEX_NONE;
+		int32 HeadChangeset = INDEX_NONE;
+
+		const FRegexPattern CsPattern(TEXT("cs:(\\d+)"));
+		const FRegexPattern HeadPattern(TEXT("head:(\\d+)"));
+
+		TArray<FString> HeaderLines;
+		StdOut.ParseIntoArrayLines(HeaderLines, true);
+
+		for (const FString& Line : HeaderLines)
+		{
+			FRegexMatcher CsMatcher(CsPattern, Line);
+			if (CsMatcher.FindNext())
+			{
+				CurrentChangeset = FCString::Atoi(*CsMatcher.GetCaptureGroup(1));
+			}
+
+			FRegexMatcher HeadMatcher(HeadPattern, Line);
+			if (HeadMatcher.FindNext())
+			{
+				HeadChangeset = FCString::Atoi(*HeadMatcher.GetCaptureGroup(1));
+			}
+
+			if (OutStatus.Branch.IsEmpty())
+			{
+				FString Left = Line;
+				int32 ParenIndex = INDEX_NONE;
+				if (Left.FindChar(TEXT('('), ParenIndex))
+				{
+					Left = Left.Left(ParenIndex);
+				}
+				Left = Left.TrimStartAndEnd();
+
+				if (Left.StartsWith(TEXT("/")) || Left.StartsWith(TEXT("lb:"), ESearchCase::IgnoreCase))
+				{
+					int32 AtIndex = Left.Find(TEXT("@"));
+					if (AtIndex != INDEX_NONE)
+					{
+						Left = Left.Left(AtIndex);
+					}
+					OutStatus.Branch = Left.TrimStartAndEnd();
+				}
+			}
+		}
+
+		if (CurrentChangeset >= 0 && HeadChangeset >= 0)
+		{
+			OutStatus.bHasUpstream = true;
+			OutStatus.Behind = FMath::Max(0, HeadChangeset - CurrentChangeset);
+			OutStatus.Ahead = FMath::Max(0, CurrentChangeset - HeadChangeset);
+		}
+	}
+	else
+	{
+		const FString Combined = (StdErr + TEXT("\n") + StdOut).TrimStartAndEnd();
+		if (IsPlasticAuthError(Combined))
+		{
+			OutStatus.bAuthRequired = true;
+			OutStatus.LastError = Combined;
+			OutError = TEXT("Plastic SCM login required.");
+			return true;
+		}
+	}
+
+	StdOut.Reset();
+	StdErr.Reset();
+	ExitCode = 0;
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const FString ScopeArg = Settings && Settings->bScopeStatusToPaths
+		? FString::Printf(TEXT(" \"%s\""), *ProjectDir)
+		: FString();
+	const FString StatusArgs = MakeStatusArgs(ScopeArg);
+
+	const bool bStatusOk = RunQuery(StatusArgs, OutStatus.RepoRoot, StdOut, StdErr, ExitCode);
+	if (bStatusOk && ExitCode == 0)
+	{
+		FSafeSaveFileStatusIndex::FBuilder IndexBuilder(OutStatus.RepoRoot);
+		ParseStatusOutput(StdOut, OutStatus, &IndexBuilder);
+		OutStatus.FileIndex = DetectionCache.ResolveFileIndex(OutStatus.RepoRoot, IndexBuilder);
+	}
+	else
+	{
+		const FString Combined = (StdErr + TEXT("\n") + StdOut).TrimStartAndEnd();
+		if (IsPlasticAuthError(Combined))
+		{
+			OutStatus.bAuthRequired = true;
+			OutStatus.LastError = Combined;
+			OutError = TEXT("Plastic SCM login required.");
+		}
+		else
+		{
+			if (bFromCache)
+			{
+				DetectionCache.Invalidate();
+				return Query(ProjectDir, OutStatus, OutError);
+			}
+
+			OutStatus.LastError = StdErr.TrimStartAndEnd();
+			OutError = OutStatus.LastError;
+		}
+	}
+
+	return true;
+}
+
+bool FSafeSavePlasticStatusQuery::RunQuery(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode) const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings || !Settings->bPersistentPlasticShell || !PlasticShell.IsValid() || Runner.IsCancelled())
+	{
+		return Runner.RunPlastic(Args, WorkingDir, OutStdOut, OutStdErr, OutExitCode);
+	}
+
+	OutStdErr.Reset();
+	if (!PlasticShell->Execute(Args, WorkingDir, OutStdOut, OutExitCode, Runner.GetProcessLimits(false)))
+	{
+		if (Runner.IsCancelled())
+		{
+			return false;
+		}
+
+		// Fall back to a one-off cm so a shell that cannot start never hides status (and a missing cm is still reported).
+		return Runner.RunPlastic(Args, WorkingDir, OutStdOut, OutStdErr, OutExitCode);
+	}
+
+	if (OutExitCode != 0)
+	{
+		OutStdErr = OutStdOut;
+		if (IsPlasticAuthError(OutStdOut))
+		{
+			// The session keeps the credentials it started with; begin a new one once the user has signed in again.
+			PlasticShell->Stop();
+		}
+	}
+
+	return true;
+}
+
+FString FSafeSavePlasticStatusQuery::MakeStatusArgs(const FString& ScopeArg)
+{
+	return FString::Printf(
+		TEXT("status%s --machinereadable --noheader --controlledchanged --private --fieldseparator=%s --startlineseparator=%s --endlineseparator=%s"),
+		*ScopeArg,
+		*PlasticFieldSeparator,
+		*PlasticLineStart,
+		*PlasticLineEnd
+	);
+}
+
+void FSafeSavePlasticStatusQuery::ParseStatusOutput(const FString& Output, FSafeSaveSourceControlStatus& Status, FSafeSaveFileStatusIndex::FBuilder* IndexBuilder)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_ParsePlasticStatus, FSafeSavePlasticStatusQuery::ParseStatusOutput);
+
+	TArray<FString> Lines;
+	Output.ParseIntoArrayLines(Lines, true);
+
+	int32 ChangeCount = 0;
+	int32 UntrackedCount = 0;
+	bool bHasConflicts = false;
+
+	for (const FString& Line : Lines)
+	{
+		FString CleanLine = Line;
+		CleanLine.ReplaceInline(*PlasticLineStart, TEXT(""));
+		CleanLine.ReplaceInline(*PlasticLineEnd, TEXT(""));
+		CleanLine = CleanLine.TrimStartAndEnd();
+
+		if (CleanLine.IsEmpty())
+		{
+			continue;
+		}
+
+		TArray<FString> Fields;
+		CleanLine.ParseIntoArray(Fields, *PlasticFieldSeparator, false);
+		if (Fields.Num() == 0)
+		{
+			continue;
+		}
+
+		const FString Code = Fields[0].TrimStartAndEnd();
+		if (Code.Equals(TEXT("STATUS"), ESearchCase::IgnoreCase))
+		{
+			continue;
+		}
+
+		ChangeCount++;
+		ESafeSaveFileStatus FileStatus = ESafeSaveFileStatus::Modified;
+
+		TArray<FString> CodeParts;
+		Code.ParseIntoArray(CodeParts, TEXT("+"), true);
+		for (const FString& Part : CodeParts)
+		{
+			if (Part.Equals(TEXT("PR"), ESearchCase::IgnoreCase))
+			{
+				UntrackedCount++;
+				FileStatus = ESafeSaveFileStatus::Untracked;
+				break;
+			}
+		}
+
+		for (const FString& Field : Fields)
+		{
+			const FString UpperField = Field.ToUpper();
+			if (UpperField.Contains(TEXT("CONFLICT")))
+			{
+				bHasConflicts = true;
+				FileStatus |= ESafeSaveFileStatus::Conflicted;
+				break;
+			}
+			if (UpperField.Contains(TEXT("MERGE")) && !UpperField.Contains(TEXT("NO_MERGES")))
+			{
+				bHasConflicts = true;
+				FileStatus |= ESafeSaveFileStatus::Conflicted;
+				break;
+			}
+		}
+
+		// "<code>|<path>|<isdir>|<mergeinfo>"
+		if (IndexBuilder && Fields.Num() > 1)
+		{
+			IndexBuilder->AddAbsolute(Fields[1].TrimStartAndEnd(), FileStatus);
+		}
+	}
+
+	Status.Untracked = UntrackedCount;
+	Status.Unstaged = FMath::Max(0, ChangeCount - UntrackedCount);
+	Status.bHasConflicts = bHasConflicts;
+	FSafeSaveStats::RecordParsedEntries(ChangeCount);
+}
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveFileStatusIndex.h"
+
+class FSafeSaveCommandRunner;
+class FSafeSaveDetectionCache;
+class FSafeSavePlasticShell;
+struct FSafeSaveSourceControlStatus;
+
+/**
+ * The Plastic SCM side of a status refresh: finds the workspace, reads branch and changeset position from the
+ * status header and parses `cm status --machinereadable`. Queries go through a persistent `cm shell` once
+ * StartShell was called and the settings enable it. Any thread.
+ */
+class FSafeSavePlasticStatusQuery
+{
+public:
+	FSafeSavePlasticStatusQuery(const FSafeSaveCommandRunner& InRunner, FSafeSaveDetectionCache& InDetectionCache);
+	~FSafeSavePlasticStatusQuery();
+
+	/** Full status of the workspace containing ProjectDir. Returns false when there is no cm or no workspace. */
+	bool Query(const FString& ProjectDir, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const;
+
+	/** Creates the persistent cm session; it starts with the first query that uses it. Game thread. */
+	void StartShell();
+	/** Ends the persistent cm session, if any. */
+	void StopShell();
+
+	/** `cm status` arguments for the SafeSave field/line separators; ScopeArg is empty or " \"<path>\"". */
+	static FString MakeStatusArgs(const FString& ScopeArg);
+	/** Parses `cm status --machinereadable` output produced with MakeStatusArgs. */
+	static void ParseStatusOutput(const FString& Output, FSafeSaveSourceControlStatus& Status, FSafeSaveFileStatusIndex::FBuilder* IndexBuilder);
+
+private:
+	/** Status queries go through the persistent cm shell when enabled; commands run by the user still use RunPlastic. */
+	bool RunQuery(const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode) const;
+
+	const FSafeSaveCommandRunner& Runner;
+	FSafeSaveDetectionCache& DetectionCache;
+	TUniquePtr<FSafeSavePlasticShell> PlasticShell;
+};
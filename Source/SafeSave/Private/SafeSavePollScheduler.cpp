@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSavePollScheduler.h"
+
+#include "SafeSaveSettings.h"
+
+#include "Editor.h"
+#include "Framework/Application/SlateApplication.h"
+
+namespace
+{
+	// Each backoff step is randomized by this fraction so editors sharing a server don't poll in lockstep.
+	constexpr double BackoffJitter = 0.2;
+}
+
+bool FSafeSavePollScheduler::Update(double NowSeconds, const USafeSaveSettings* Settings)
+{
+	const ERelaxReason PreviousReason = RelaxReason;
+	RelaxReason = ERelaxReason::None;
+	ActivityMultiplier = 1.0;
+
+	if (!Settings || !Settings->bAdaptivePolling)
+	{
+		return false;
+	}
+
+	if (GEditor && GEditor->IsPlaySessionInProgress())
+	{
+		RelaxReason = ERelaxReason::PlayInEditor;
+		ActivityMultiplier = Settings->PlayInEditorIntervalMultiplier;
+	}
+	else if (FSlateApplication::IsInitialized())
+	{
+		const FSlateApplication& SlateApp = FSlateApplication::Get();
+		if (!SlateApp.IsActive())
+		{
+			RelaxReason = ERelaxReason::Background;
+			ActivityMultiplier = Settings->BackgroundIntervalMultiplier;
+		}
+		else if (NowSeconds - SlateApp.GetLastUserInteractionTime() >= Settings->IdleThresholdSeconds)
+		{
+			RelaxReason = ERelaxReason::Idle;
+			ActivityMultiplier = Settings->BackgroundIntervalMultiplier;
+		}
+	}
+
+	ActivityMultiplier = FMath::Max(1.0, ActivityMultiplier);
+	return PreviousReason != ERelaxReason::None && RelaxReason == ERelaxReason::None;
+}
+
+void FSafeSavePollScheduler::RecordStatusResult(bool bSuccess, double BaseSeconds, const USafeSaveSettings* Settings)
+{
+	if (bSuccess || !Settings || !Settings->bAdaptivePolling)
+	{
+		ResetBackoff();
+		return;
+	}
+
+	++ConsecutiveFailures;
+
+	const double MaxBackoff = FMath::Max(BaseSeconds, (double)Settings->MaxFailureBackoffSeconds);
+	const double Exponent = FMath::Min(ConsecutiveFailures, 16);
+	const double Target = FMath::Min(MaxBackoff, BaseSeconds * FMath::Pow(2.0, Exponent));
+	BackoffSeconds = FMath::Min(MaxBackoff, Target * FMath::FRandRange(1.0 - BackoffJitter, 1.0 + BackoffJitter));
+}
+
+void FSafeSavePollScheduler::ResetBackoff()
+{
+	ConsecutiveFailures = 0;
+	BackoffSeconds = 0.0;
+}
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USafeSaveSettings;
+
+/**
+ * Scales the status service's poll intervals to what the editor is doing: relaxed while the editor is
+ * in the background, idle, playing in editor or running a commandlet, and backed off exponentially (with
+ * jitter) while source control queries keep failing. Game thread only.
+ */
+class FSafeSavePollScheduler
+{
+public:
+	/** Why the intervals are currently stretched; None means polling at the configured rate. */
+	enum class ERelaxReason : uint8
+	{
+		None,
+		Background,
+		Idle,
+		PlayInEditor
+	};
+
+	/** Samples focus, PIE and user activity. Returns true when the editor just went from relaxed back to active. */
+	bool Update(double NowSeconds, const USafeSaveSettings* Settings);
+
+	/** BaseSeconds stretched by the current activity multiplier. */
+	double ScaleInterval(double BaseSeconds) const { return BaseSeconds * ActivityMultiplier; }
+	/** Source control poll interval: the scaled interval, or the failure backoff if that is longer. */
+	double GetStatusInterval(double BaseSeconds) const { return FMath::Max(ScaleInterval(BaseSeconds), BackoffSeconds); }
+
+	/** Call when a status query completes; failures grow the backoff from BaseSeconds, a success clears it. */
+	void RecordStatusResult(bool bSuccess, double BaseSeconds, const USafeSaveSettings* Settings);
+	void ResetBackoff();
+
+	ERelaxReason GetRelaxReason() const { return RelaxReason; }
+	int32 GetConsecutiveFailures() const { return ConsecutiveFailures; }
+	double GetBackoffSeconds() const { return BackoffSeconds; }
+
+private:
+	double ActivityMultiplier = 1.0;
+	double BackoffSeconds = 0.0;
+	int32 ConsecutiveFailures = 0;
+	ERelaxReason RelaxReason = ERelaxReason::None;
+};
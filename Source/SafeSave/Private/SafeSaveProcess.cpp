@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveProcess.h"
+
+#include "SafeSaveStats.h"
+
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	FString BytesToString(const TArray<uint8>& Bytes)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+bool FSafeSaveProcess::Run(const FString& Executable, const FString& Args, const FString& WorkingDir, FOnOutput OnStdOut, FString& OutStdErr, int32& OutExitCode, const FLimits& Limits)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_RunProcess, FSafeSaveProcess::Run);
+
+	OutStdErr.Reset();
+	OutExitCode = -1;
+
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdErrRead = nullptr;
+	void* StdErrWrite = nullptr;
+	if (!FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite))
+	{
+		return false;
+	}
+	if (!FPlatformProcess::CreatePipe(StdErrRead, StdErrWrite))
+	{
+		FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+		return false;
+	}
+
+	FProcHandle Process = FPlatformProcess::CreateProc(
+		*Executable,
+		*Args,
+		false,
+		true,
+		true,
+		nullptr,
+		0,
+		WorkingDir.IsEmpty() ? nullptr : *WorkingDir,
+		StdOutWrite,
+		nullptr,
+		StdErrWrite
+	);
+
+	if (!Process.IsValid())
+	{
+		FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+		FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+		return false;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	TArray<uint8> Chunk;
+	TArray<uint8> StdErrBytes;
+	const auto DrainPipes = [&]()
+	{
+		bool bReadAny = false;
+		while (FPlatformProcess::ReadPipeToArray(StdOutRead, Chunk) && Chunk.Num() > 0)
+		{
+			OnStdOut(Chunk.GetData(), Chunk.Num());
+			bReadAny = true;
+		}
+		// Stderr is drained too, or a chatty child could block on a full pipe and never exit.
+		while (FPlatformProcess::ReadPipeToArray(StdErrRead, Chunk) && Chunk.Num() > 0)
+		{
+			StdErrBytes.Append(Chunk);
+			bReadAny = true;
+		}
+		return bReadAny;
+	};
+
+	FString KillReason;
+	for (;;)
+	{
+		// Sample before reading so output written just before exit is still collected below.
+		const bool bRunning = FPlatformProcess::IsProcRunning(Process);
+		const bool bReadAny = DrainPipes();
+		if (!bRunning)
+		{
+			DrainPipes();
+			break;
+		}
+
+		// A git waiting on a credential prompt or a stalled network share would otherwise hold the worker forever.
+		const bool bCancelled = Limits.CancelFlag && Limits.CancelFlag->Load();
+		const bool bTimedOut = Limits.TimeoutSeconds > 0.0 && FPlatformTime::Seconds() - StartSeconds > Limits.TimeoutSeconds;
+		if (bCancelled || bTimedOut)
+		{
+			KillReason = bCancelled
+				? FString::Printf(TEXT("%s was cancelled."), *FPaths::GetBaseFilename(Executable))
+				: FString::Printf(TEXT("%s did not finish within %.0f seconds and was stopped."), *FPaths::GetBaseFilename(Executable), Limits.TimeoutSeconds);
+			FPlatformProcess::TerminateProc(Process, true);
+			FPlatformProcess::WaitForProc(Process);
+			DrainPipes();
+			break;
+		}
+		if (!bReadAny)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+
+	FSafeSaveStats::RecordProcess(FPlatformTime::Seconds() - StartSeconds, true);
+
+	if (KillReason.IsEmpty())
+	{
+		FPlatformProcess::GetProcReturnCode(Process, &OutExitCode);
+	}
+	FPlatformProcess::CloseProc(Process);
+	FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+	FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+
+	OutStdErr = BytesToString(StdErrBytes);
+	if (!KillReason.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[SafeSave] %s (%s)"), *KillReason, *Args);
+		OutExitCode = -1;
+		OutStdErr = OutStdErr.IsEmpty() ? KillReason : KillReason + TEXT("\n") + OutStdErr;
+	}
+	return true;
+}
+
+bool FSafeSaveProcess::RunAndCapture(const FString& Executable, const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, const FLimits& Limits)
+{
+	TArray<uint8> StdOutBytes;
+	const bool bLaunched = Run(Executable, Args, WorkingDir, [&StdOutBytes](const uint8* Data, int32 Num)
+	{
+		StdOutBytes.Append(Data, Num);
+	}, OutStdErr, OutExitCode, Limits);
+
+	OutStdOut = BytesToString(StdOutBytes);
+	return bLaunched;
+}
+
+FSafeSaveProcessGroup::~FSafeSaveProcessGroup()
+{
+	for (const TUniquePtr<FEntry>& Entry : Entries)
+	{
+		if (!Entry->bFinished && Entry->Process.IsValid())
+		{
+			FPlatformProcess::TerminateProc(Entry->Process, true);
+			Close(*Entry, FString::Printf(TEXT("%s was abandoned."), *Entry->Name));
+		}
+	}
+}
+
+int32 FSafeSaveProcessGroup::Launch(const FString& Executable, const FString& Args, const FString& WorkingDir, FOnOutput&& OnStdOut)
+{
+	TUniquePtr<FEntry>& Entry = Entries.Add_GetRef(MakeUnique<FEntry>());
+	Entry->Name = FPaths::GetBaseFilename(Executable);
+	Entry->Args = Args;
+	Entry->OnStdOut = MoveTemp(OnStdOut);
+
+	if (!FPlatformProcess::CreatePipe(Entry->StdOutRead, Entry->StdOutWrite))
+	{
+		return Entries.Num() - 1;
+	}
+	if (!FPlatformProcess::CreatePipe(Entry->StdErrRead, Entry->StdErrWrite))
+	{
+		FPlatformProcess::ClosePipe(Entry->StdOutRead, Entry->StdOutWrite);
+		Entry->StdOutRead = Entry->StdOutWrite = nullptr;
+		return Entries.Num() - 1;
+	}
+
+	Entry->Process = FPlatformProcess::CreateProc(
+		*Executable,
+		*Args,
+		false,
+		true,
+		true,
+		nullptr,
+		0,
+		WorkingDir.IsEmpty() ? nullptr : *WorkingDir,
+		Entry->StdOutWrite,
+		nullptr,
+		Entry->StdErrWrite
+	);
+
+	if (!Entry->Process.IsValid())
+	{
+		FPlatformProcess::ClosePipe(Entry->StdOutRead, Entry->StdOutWrite);
+		FPlatformProcess::ClosePipe(Entry->StdErrRead, Entry->StdErrWrite);
+		Entry->StdOutRead = Entry->StdOutWrite = Entry->StdErrRead = Entry->StdErrWrite = nullptr;
+	}
+
+	Entry->StartSeconds = FPlatformTime::Seconds();
+	return Entries.Num() - 1;
+}
+
+void FSafeSaveProcessGroup::WaitAll(const FSafeSaveProcess::FLimits& Limits)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_RunProcess, FSafeSaveProcessGroup::WaitAll);
+
+	TArray<uint8> Chunk;
+	for (;;)
+	{
+		bool bAnyRunning = false;
+		bool bReadAny = false;
+		const bool bCancelled = Limits.CancelFlag && Limits.CancelFlag->Load();
+
+		for (const TUniquePtr<FEntry>& EntryPtr : Entries)
+		{
+			FEntry& Entry = *EntryPtr;
+			if (Entry.bFinished || !Entry.Process.IsValid())
+			{
+				continue;
+			}
+
+			const bool bRunning = FPlatformProcess::IsProcRunning(Entry.Process);
+			bReadAny |= Drain(Entry, Chunk);
+			if (!bRunning)
+			{
+				Drain(Entry, Chunk);
+				Close(Entry, FString());
+				continue;
+			}
+
+			const bool bTimedOut = Limits.TimeoutSeconds > 0.0 && FPlatformTime::Seconds() - Entry.StartSeconds > Limits.TimeoutSeconds;
+			if (bCancelled || bTimedOut)
+			{
+				FPlatformProcess::TerminateProc(Entry.Process, true);
+				FPlatformProcess::WaitForProc(Entry.Process);
+				Drain(Entry, Chunk);
+				Close(Entry, bCancelled
+					? FString::Printf(TEXT("%s was cancelled."), *Entry.Name)
+					: FString::Printf(TEXT("%s did not finish within %.0f seconds and was stopped."), *Entry.Name, Limits.TimeoutSeconds));
+				continue;
+			}
+
+			bAnyRunning = true;
+		}
+
+		if (!bAnyRunning)
+		{
+			break;
+		}
+		if (!bReadAny)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+}
+
+bool FSafeSaveProcessGroup::Drain(FEntry& Entry, TArray<uint8>& Chunk)
+{
+	bool bReadAny = false;
+	while (FPlatformProcess::ReadPipeToArray(Entry.StdOutRead, Chunk) && Chunk.Num() > 0)
+	{
+		Entry.OnStdOut(Chunk.GetData(), Chunk.Num());
+		bReadAny = true;
+	}
+	while (FPlatformProcess::ReadPipeToArray(Entry.StdErrRead, Chunk) && Chunk.Num() > 0)
+	{
+		Entry.StdErrBytes.Append(Chunk);
+		bReadAny = true;
+	}
+	return bReadAny;
+}
+
+void FSafeSaveProcessGroup::Close(FEntry& Entry, const FString& KillReason)
+{
+	FSafeSaveStats::RecordProcess(FPlatformTime::Seconds() - Entry.StartSeconds, true);
+
+	if (KillReason.IsEmpty())
+	{
+		FPlatformProcess::GetProcReturnCode(Entry.Process, &Entry.ExitCode);
+	}
+	FPlatformProcess::CloseProc(Entry.Process);
+	FPlatformProcess::ClosePipe(Entry.StdOutRead, Entry.StdOutWrite);
+	FPlatformProcess::ClosePipe(Entry.StdErrRead, Entry.StdErrWrite);
+	Entry.StdOutRead = Entry.StdOutWrite = Entry.StdErrRead = Entry.StdErrWrite = nullptr;
+	Entry.bFinished = true;
+
+	Entry.StdErr = BytesToString(Entry.StdErrBytes);
+	Entry.StdErrBytes.Empty();
+	if (!KillReason.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[SafeSave] %s (%s)"), *KillReason, *Entry.Args);
+		Entry.ExitCode = -1;
+		Entry.StdErr = Entry.StdErr.IsEmpty() ? KillReason : KillReason + TEXT("\n") + Entry.StdErr;
+	}
+}
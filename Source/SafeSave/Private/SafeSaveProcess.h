@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+/**
+ * Launches command line tools with their output attached to pipes. Unlike FPlatformProcess::ExecProcess,
+ * stdout is handed to the caller in chunks as it is read, so large outputs never have to be held as one FString.
+ */
+class FSafeSaveProcess
+{
+public:
+	/** Receives raw (UTF-8) stdout bytes; a chunk boundary may fall anywhere, including inside a character. */
+	using FOnOutput = TFunctionRef<void(const uint8* Data, int32 Num)>;
+
+	/** Bounds on how long Run waits. A process that exceeds them is killed (with its children) and reported on stderr. */
+	struct FLimits
+	{
+		/** 0 waits for as long as the process runs. */
+		double TimeoutSeconds = 0.0;
+		/** Polled while waiting; setting it to true kills the process. */
+		const TAtomic<bool>* CancelFlag = nullptr;
+	};
+
+	/**
+	 * Runs Executable until it exits or Limits are exceeded. Returns false if it could not be launched.
+	 * A killed process reports exit code -1 and an explanation in OutStdErr.
+	 */
+	static bool Run(const FString& Executable, const FString& Args, const FString& WorkingDir, FOnOutput OnStdOut, FString& OutStdErr, int32& OutExitCode, const FLimits& Limits = FLimits());
+
+	/** Run, collecting stdout into OutStdOut; an ExecProcess replacement that honors Limits. */
+	static bool RunAndCapture(const FString& Executable, const FString& Args, const FString& WorkingDir, FString& OutStdOut, FString& OutStdErr, int32& OutExitCode, const FLimits& Limits = FLimits());
+};
+
+/**
+ * Several processes launched together and drained from one thread, so their run times overlap: waiting
+ * for N repositories costs about as long as the slowest one instead of the sum. Processes keep running
+ * between Launch and WaitAll (a full pipe just pauses them until they are drained).
+ */
+class FSafeSaveProcessGroup
+{
+public:
+	using FOnOutput = TFunction<void(const uint8* Data, int32 Num)>;
+
+	FSafeSaveProcessGroup() = default;
+	~FSafeSaveProcessGroup();
+
+	FSafeSaveProcessGroup(const FSafeSaveProcessGroup&) = delete;
+	FSafeSaveProcessGroup& operator=(const FSafeSaveProcessGroup&) = delete;
+
+	/** Starts a process and returns its index; check WasLaunched for failures. */
+	int32 Launch(const FString& Executable, const FString& Args, const FString& WorkingDir, FOnOutput&& OnStdOut);
+
+	/** Drains every process until it exits or exceeds Limits (measured from its own launch); killed ones report -1. */
+	void WaitAll(const FSafeSaveProcess::FLimits& Limits);
+
+	int32 Num() const { return Entries.Num(); }
+	bool WasLaunched(int32 Index) const { return Entries[Index]->Process.IsValid() || Entries[Index]->bFinished; }
+	int32 GetExitCode(int32 Index) const { return Entries[Index]->ExitCode; }
+	const FString& GetStdErr(int32 Index) const { return Entries[Index]->StdErr; }
+
+private:
+	struct FEntry
+	{
+		FString Name;
+		FString Args;
+		FProcHandle Process;
+		void* StdOutRead = nullptr;
+		void* StdOutWrite = nullptr;
+		void* StdErrRead = nullptr;
+		void* StdErrWrite = nullptr;
+		FOnOutput OnStdOut;
+		TArray<uint8> StdErrBytes;
+		FString StdErr;
+		double StartSeconds = 0.0;
+		int32 ExitCode = -1;
+		bool bFinished = false;
+	};
+
+	static bool Drain(FEntry& Entry, TArray<uint8>& Chunk);
+	static void Close(FEntry& Entry, const FString& KillReason);
+
+	TArray<TUniquePtr<FEntry>> Entries;
+};
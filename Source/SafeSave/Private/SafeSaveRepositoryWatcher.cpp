@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveRepositoryWatcher.h"
+
+#include "SafeSaveGitRepository.h"
+
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	IDirectoryWatcher* GetDirectoryWatcher()
+	{
+		FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		return DirectoryWatcherModule.Get();
+	}
+}
+
+FSafeSaveRepositoryWatcher::~FSafeSaveRepositoryWatcher()
+{
+	Stop();
+}
+
+void FSafeSaveRepositoryWatcher::Watch(const FString& RepoRoot)
+{
+	if (RepoRoot.IsEmpty())
+	{
+		Stop();
+		return;
+	}
+
+	if (IsWatching() && WatchedRoot == RepoRoot)
+	{
+		return;
+	}
+
+	Stop();
+
+	const FString GitDir = FSafeSaveGitRepository::ResolveGitDir(RepoRoot);
+	if (GitDir.IsEmpty())
+	{
+		return;
+	}
+
+	const FString CommonDir = FSafeSaveGitRepository::ResolveCommonGitDir(GitDir);
+	const uint32 MetadataFlags = IDirectoryWatcher::WatchOptions::IgnoreChangesInSubtree;
+
+	Register(GitDir, MetadataFlags, true);
+	if (CommonDir != GitDir)
+	{
+		Register(CommonDir, MetadataFlags, true);
+	}
+	Register(CommonDir / TEXT("refs"), 0, false);
+
+	if (IsWatching())
+	{
+		WatchedRoot = RepoRoot;
+	}
+}
+
+void FSafeSaveRepositoryWatcher::Stop()
+{
+	if (Registrations.Num() > 0 && FModuleManager::Get().IsModuleLoaded(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher())
+		{
+			for (const FRegistration& Registration : Registrations)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Registration.Directory, Registration.Handle);
+			}
+		}
+	}
+
+	Registrations.Reset();
+	WatchedRoot.Reset();
+}
+
+bool FSafeSaveRepositoryWatcher::Register(const FString& Directory, uint32 Flags, bool bFilterToMetadataFiles)
+{
+	IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher();
+	if (!DirectoryWatcher || !FPaths::DirectoryExists(Directory))
+	{
+		return false;
+	}
+
+	const IDirectoryWatcher::FDirectoryChanged Callback = bFilterToMetadataFiles
+		? IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FSafeSaveRepositoryWatcher::HandleMetadataChanged)
+		: IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FSafeSaveRepositoryWatcher::HandleRefsChanged);
+
+	FRegistration Registration;
+	Registration.Directory = Directory;
+	if (!DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, Callback, Registration.Handle, Flags))
+	{
+		return false;
+	}
+
+	Registrations.Add(MoveTemp(Registration));
+	return true;
+}
+
+void FSafeSaveRepositoryWatcher::HandleMetadataChanged(const TArray<FFileChangeData>& Changes)
+{
+	bool bAnyChange = false;
+	bool bIndexOnly = true;
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		const FString Filename = FPaths::GetCleanFilename(Change.Filename);
+		if (IsWatchedMetadataFile(Filename))
+		{
+			bAnyChange = true;
+			bIndexOnly &= Filename == TEXT("index");
+		}
+	}
+
+	if (bAnyChange)
+	{
+		RepositoryChangedEvent.Broadcast(bIndexOnly);
+	}
+}
+
+void FSafeSaveRepositoryWatcher::HandleRefsChanged(const TArray<FFileChangeData>& Changes)
+{
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (!Change.Filename.EndsWith(TEXT(".lock")))
+		{
+			RepositoryChangedEvent.Broadcast(false);
+			return;
+		}
+	}
+}
+
+bool FSafeSaveRepositoryWatcher::IsWatchedMetadataFile(const FString& Filename)
+{
+	return Filename == TEXT("HEAD")
+		|| Filename == TEXT("index")
+		|| Filename == TEXT("packed-refs")
+		|| Filename == TEXT("config")
+		|| Filename == TEXT("FETCH_HEAD")
+		|| Filename == TEXT("ORIG_HEAD")
+		|| Filename == TEXT("MERGE_HEAD");
+}
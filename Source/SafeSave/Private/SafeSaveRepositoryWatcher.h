@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFileChangeData;
+
+/**
+ * Watches the files git rewrites when HEAD, the index, any ref or the repository config changes (HEAD, index,
+ * packed-refs, config, FETCH_HEAD, refs/...) and fires OnRepositoryChanged, so status can be refreshed on
+ * demand instead of polled.
+ */
+class FSafeSaveRepositoryWatcher
+{
+public:
+	/** bIndexOnly is set when the only change was a rewrite of .git/index (e.g. git refreshing its caches). */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnRepositoryChanged, bool /*bIndexOnly*/);
+
+	~FSafeSaveRepositoryWatcher();
+
+	/** Starts watching the git metadata of RepoRoot. Does nothing if RepoRoot is already watched. */
+	void Watch(const FString& RepoRoot);
+	void Stop();
+
+	bool IsWatching() const { return Registrations.Num() > 0; }
+	const FString& GetWatchedRoot() const { return WatchedRoot; }
+
+	FOnRepositoryChanged& OnRepositoryChanged() { return RepositoryChangedEvent; }
+
+private:
+	struct FRegistration
+	{
+		FString Directory;
+		FDelegateHandle Handle;
+	};
+
+	bool Register(const FString& Directory, uint32 Flags, bool bFilterToMetadataFiles);
+	void HandleMetadataChanged(const TArray<FFileChangeData>& Changes);
+	void HandleRefsChanged(const TArray<FFileChangeData>& Changes);
+
+	static bool IsWatchedMetadataFile(const FString& Filename);
+
+	FString WatchedRoot;
+	TArray<FRegistration> Registrations;
+	FOnRepositoryChanged RepositoryChangedEvent;
+};
@@ -4,10 +4,42 @@
 
 USafeSaveSettings::USafeSaveSettings()
 {
+	bDeferStartupRefresh = true;
 	DirtyCheckIntervalSeconds = 1.0f;
+	bEventDrivenDirtyTracking = true;
+	DirtyReconcileIntervalSeconds = 30.0f;
+	UnsavedExcludePaths = { TEXT("/Temp/"), TEXT("/Engine/"), TEXT("/Script/"), TEXT("/Memory/") };
+	UnsavedExcludeNameMarkers = { TEXT("InstanceOf_") };
+	bAdaptivePolling = true;
+	BackgroundIntervalMultiplier = 4.0f;
+	PlayInEditorIntervalMultiplier = 6.0f;
+	IdleThresholdSeconds = 300.0f;
+	MaxFailureBackoffSeconds = 300.0f;
 	GitCheckIntervalSeconds = 5.0f;
+	StatusSource = ESafeSaveStatusSource::EditorProvider;
+	bShareStatusAcrossProcesses = true;
+	SharedStatusMaxAgeSeconds = 10.0f;
+	GitBackend = ESafeSaveGitBackend::ProcessPerQuery;
+	GitStatusScanMode = ESafeSaveGitStatusScanMode::Full;
+	UntrackedScanIntervalSeconds = 120.0f;
+	bIncludeSubmodules = true;
+	bScopeStatusToPaths = false;
+	StatusScopePaths = { TEXT("Content"), TEXT("Config"), TEXT("Source"), TEXT("Plugins") };
+	bLazyAheadBehind = true;
+	bWatchRepositoryForChanges = true;
+	WatcherSafetyNetIntervalSeconds = 60.0f;
+	bPersistentPlasticShell = true;
+	StatusQueryTimeoutSeconds = 30.0f;
+	RemoteCommandTimeoutSeconds = 300.0f;
 	bAutoFetch = false;
 	AutoFetchIntervalSeconds = 120.0f;
+	AutoFetchMode = ESafeSaveAutoFetchMode::UpstreamOnly;
+	FullFetchIntervalSeconds = 3600.0f;
+	bReloadChangedPackagesAfterSync = true;
+	bQueryLocks = false;
+	LockRefreshIntervalSeconds = 120.0f;
+	bSkipUnchangedOnSaveAll = false;
 	bToastOnStatusChange = true;
 	StatusToastMinIntervalSeconds = 4.0f;
+	bWarnOnLockedAssets = true;
 }
@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveSharedStatusCache.h"
+
+#include "SafeSaveFileStatusIndex.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	// Bump when the layout changes; files of another version are ignored.
+	constexpr int32 SharedStatusVersion = 1;
+
+	// Short lock attempts so a cancelled query does not sit out the whole timeout.
+	constexpr double LockAttemptSeconds = 0.25;
+
+	ESafeSaveSourceControlProvider ProviderFromString(const FString& Text)
+	{
+		if (Text == TEXT("Git"))
+		{
+			return ESafeSaveSourceControlProvider::Git;
+		}
+		if (Text == TEXT("Plastic"))
+		{
+			return ESafeSaveSourceControlProvider::Plastic;
+		}
+		return ESafeSaveSourceControlProvider::None;
+	}
+
+	bool TryGetDateTime(const FJsonObject& Object, const FString& Field, FDateTime& OutValue)
+	{
+		FString Text;
+		return Object.TryGetStringField(Field, Text) && FDateTime::ParseIso8601(*Text, OutValue);
+	}
+
+	TSharedPtr<FJsonObject> LoadJsonFile(const FString& Filename)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *Filename))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+		{
+			return nullptr;
+		}
+		return Root;
+	}
+
+	/** Written to a temporary file and moved into place so readers never see a partial file. */
+	void SaveJsonFile(const FString& Filename, const TSharedRef<FJsonObject>& Root)
+	{
+		FString Text;
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+		if (!FJsonSerializer::Serialize(Root, Writer))
+		{
+			return;
+		}
+
+		const FString TempFilename = FString::Printf(TEXT("%s.%u.tmp"), *Filename, FPlatformProcess::GetCurrentProcessId());
+		if (!FFileHelper::SaveStringToFile(Text, *TempFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SafeSave] Could not write %s."), *TempFilename);
+			return;
+		}
+
+		if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+		{
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+		}
+	}
+}
+
+FSafeSaveSharedStatusCache::FSafeSaveSharedStatusCache(const FString& InProjectDir)
+	: ProjectDir(InProjectDir)
+{
+	const FString SafeSaveDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()) / TEXT("SafeSave");
+	CacheFilename = SafeSaveDir / TEXT("SharedStatus.json");
+	LastKnownFilename = SafeSaveDir / TEXT("LastStatus.json");
+
+	// The lock is system wide, so its name must tell projects apart.
+	LockName = FString::Printf(TEXT("SafeSaveStatus_%08x"), GetTypeHash(ProjectDir.ToLower()));
+}
+
+bool FSafeSaveSharedStatusCache::TryRead(uint32 SettingsHash, const FDateTime& MinQueryStartUtc, FSafeSaveSourceControlStatus& OutStatus) const
+{
+	const TSharedPtr<FJsonObject> Root = LoadJsonFile(CacheFilename);
+	if (!Root.IsValid())
+	{
+		return false;
+	}
+
+	int32 Version = 0;
+	uint32 FileSettingsHash = 0;
+	FString FileProjectDir;
+	FDateTime QueryStartUtc;
+	if (!Root->TryGetNumberField(TEXT("version"), Version) || Version != SharedStatusVersion
+		|| !Root->TryGetNumberField(TEXT("settingsHash"), FileSettingsHash) || FileSettingsHash != SettingsHash
+		|| !Root->TryGetStringField(TEXT("projectDir"), FileProjectDir) || !FileProjectDir.Equals(ProjectDir, ESearchCase::IgnoreCase)
+		|| !TryGetDateTime(*Root, TEXT("queryStartedUtc"), QueryStartUtc) || QueryStartUtc < MinQueryStartUtc)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* StatusObject = nullptr;
+	return Root->TryGetObjectField(TEXT("status"), StatusObject) && StatusFromJson(**StatusObject, OutStatus);
+}
+
+void FSafeSaveSharedStatusCache::Write(uint32 SettingsHash, const FDateTime& QueryStartUtc, const FSafeSaveSourceControlStatus& Status) const
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), SharedStatusVersion);
+	Root->SetNumberField(TEXT("settingsHash"), SettingsHash);
+	Root->SetStringField(TEXT("projectDir"), ProjectDir);
+	Root->SetStringField(TEXT("queryStartedUtc"), QueryStartUtc.ToIso8601());
+	Root->SetNumberField(TEXT("processId"), FPlatformProcess::GetCurrentProcessId());
+	Root->SetObjectField(TEXT("status"), StatusToJson(Status));
+	SaveJsonFile(CacheFilename, Root);
+}
+
+void FSafeSaveSharedStatusCache::WriteLastKnown(const FSafeSaveSourceControlStatus& Status) const
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), SharedStatusVersion);
+	Root->SetStringField(TEXT("projectDir"), ProjectDir);
+	Root->SetObjectField(TEXT("status"), StatusToJson(Status));
+	SaveJsonFile(LastKnownFilename, Root);
+}
+
+bool FSafeSaveSharedStatusCache::ReadLastKnown(FSafeSaveSourceControlStatus& OutStatus) const
+{
+	const TSharedPtr<FJsonObject> Root = LoadJsonFile(LastKnownFilename);
+	int32 Version = 0;
+	FString FileProjectDir;
+	const TSharedPtr<FJsonObject>* StatusObject = nullptr;
+	if (!Root.IsValid()
+		|| !Root->TryGetNumberField(TEXT("version"), Version) || Version != SharedStatusVersion
+		|| !Root->TryGetStringField(TEXT("projectDir"), FileProjectDir) || !FileProjectDir.Equals(ProjectDir, ESearchCase::IgnoreCase)
+		|| !Root->TryGetObjectField(TEXT("status"), StatusObject) || !StatusFromJson(**StatusObject, OutStatus))
+	{
+		return false;
+	}
+
+	OutStatus.bStale = true;
+	return true;
+}
+
+TUniquePtr<FSystemWideCriticalSection> FSafeSaveSharedStatusCache::Lock(double TimeoutSeconds, const TAtomic<bool>* CancelFlag) const
+{
+	const double Deadline = FPlatformTime::Seconds() + FMath::Max(LockAttemptSeconds, TimeoutSeconds);
+	while (!CancelFlag || !CancelFlag->Load())
+	{
+		TUniquePtr<FSystemWideCriticalSection> Lock = MakeUnique<FSystemWideCriticalSection>(LockName, FTimespan::FromSeconds(LockAttemptSeconds));
+		if (Lock->IsValid())
+		{
+			return Lock;
+		}
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[SafeSave] Another process held the shared status lock for over %.0f seconds; querying without it."), TimeoutSeconds);
+			break;
+		}
+	}
+	return nullptr;
+}
+
+TSharedRef<FJsonObject> FSafeSaveSharedStatusCache::StatusToJson(const FSafeSaveSourceControlStatus& Status)
+{
+	const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("provider"), ProviderToString(Status.Provider));
+	Object->SetBoolField(TEXT("clientAvailable"), Status.bClientAvailable);
+	Object->SetBoolField(TEXT("repo"), Status.bRepo);
+	Object->SetBoolField(TEXT("authRequired"), Status.bAuthRequired);
+	Object->SetBoolField(TEXT("hasUpstream"), Status.bHasUpstream);
+	Object->SetBoolField(TEXT("hasConflicts"), Status.bHasConflicts);
+	Object->SetNumberField(TEXT("ahead"), Status.Ahead);
+	Object->SetNumberField(TEXT("behind"), Status.Behind);
+	Object->SetNumberField(TEXT("staged"), Status.Staged);
+	Object->SetNumberField(TEXT("unstaged"), Status.Unstaged);
+	Object->SetNumberField(TEXT("untracked"), Status.Untracked);
+	Object->SetStringField(TEXT("branch"), Status.Branch);
+	Object->SetStringField(TEXT("headCommit"), Status.HeadCommit);
+	Object->SetStringField(TEXT("upstreamCommit"), Status.UpstreamCommit);
+	Object->SetStringField(TEXT("repoRoot"), Status.RepoRoot);
+	Object->SetStringField(TEXT("workspaceName"), Status.WorkspaceName);
+	Object->SetStringField(TEXT("lastError"), Status.LastError);
+	Object->SetStringField(TEXT("scanMode"), Status.ScanMode);
+	Object->SetStringField(TEXT("editorProvider"), Status.EditorProviderName);
+	Object->SetStringField(TEXT("lastUpdateUtc"), Status.LastUpdateUtc.ToIso8601());
+	Object->SetNumberField(TEXT("nestedRepositories"), Status.NestedRepositories);
+	Object->SetNumberField(TEXT("nestedRepositoriesFailed"), Status.NestedRepositoriesFailed);
+
+	if (Status.FileIndex.IsValid())
+	{
+		const TSharedRef<FJsonObject> Files = MakeShared<FJsonObject>();
+		Status.FileIndex->ForEach([&Files](FName PackageName, ESafeSaveFileStatus FileStatus)
+		{
+			Files->SetNumberField(PackageName.ToString(), (uint8)FileStatus);
+		});
+		Object->SetNumberField(TEXT("fileIndexChecksum"), Status.FileIndex->GetChecksum());
+		Object->SetObjectField(TEXT("files"), Files);
+	}
+
+	return Object;
+}
+
+bool FSafeSaveSharedStatusCache::StatusFromJson(const FJsonObject& Object, FSafeSaveSourceControlStatus& OutStatus)
+{
+	FSafeSaveSourceControlStatus Status;
+
+	FString Provider;
+	if (!Object.TryGetStringField(TEXT("provider"), Provider)
+		|| !Object.TryGetBoolField(TEXT("clientAvailable"), Status.bClientAvailable)
+		|| !Object.TryGetBoolField(TEXT("repo"), Status.bRepo))
+	{
+		return false;
+	}
+
+	Status.Provider = ProviderFromString(Provider);
+	Object.TryGetBoolField(TEXT("authRequired"), Status.bAuthRequired);
+	Object.TryGetBoolField(TEXT("hasUpstream"), Status.bHasUpstream);
+	Object.TryGetBoolField(TEXT("hasConflicts"), Status.bHasConflicts);
+	Object.TryGetNumberField(TEXT("ahead"), Status.Ahead);
+	Object.TryGetNumberField(TEXT("behind"), Status.Behind);
+	Object.TryGetNumberField(TEXT("staged"), Status.Staged);
+	Object.TryGetNumberField(TEXT("unstaged"), Status.Unstaged);
+	Object.TryGetNumberField(TEXT("untracked"), Status.Untracked);
+	Object.TryGetStringField(TEXT("branch"), Status.Branch);
+	Object.TryGetStringField(TEXT("headCommit"), Status.HeadCommit);
+	Object.TryGetStringField(TEXT("upstreamCommit"), Status.UpstreamCommit);
+	Object.TryGetStringField(TEXT("repoRoot"), Status.RepoRoot);
+	Object.TryGetStringField(TEXT("workspaceName"), Status.WorkspaceName);
+	Object.TryGetStringField(TEXT("lastError"), Status.LastError);
+	Object.TryGetStringField(TEXT("scanMode"), Status.ScanMode);
+	Object.TryGetStringField(TEXT("editorProvider"), Status.EditorProviderName);
+	TryGetDateTime(Object, TEXT("lastUpdateUtc"), Status.LastUpdateUtc);
+	Object.TryGetNumberField(TEXT("nestedRepositories"), Status.NestedRepositories);
+	Object.TryGetNumberField(TEXT("nestedRepositoriesFailed"), Status.NestedRepositoriesFailed);
+
+	const TSharedPtr<FJsonObject>* Files = nullptr;
+	if (Object.TryGetObjectField(TEXT("files"), Files))
+	{
+		TMap<FName, ESafeSaveFileStatus> Entries;
+		Entries.Reserve((*Files)->Values.Num());
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Files)->Values)
+		{
+			double Flags = 0.0;
+			if (Entry.Value.IsValid() && Entry.Value->TryGetNumber(Flags) && Entry.Key.Len() < NAME_SIZE)
+			{
+				Entries.Add(FName(*Entry.Key), (ESafeSaveFileStatus)(uint8)Flags);
+			}
+		}
+
+		uint32 Checksum = 0;
+		Object.TryGetNumberField(TEXT("fileIndexChecksum"), Checksum);
+		Status.FileIndex = FSafeSaveFileStatusIndex::FromEntries(MoveTemp(Entries), Checksum);
+	}
+
+	OutStatus = MoveTemp(Status);
+	return true;
+}
+
+FString FSafeSaveSharedStatusCache::ProviderToString(ESafeSaveSourceControlProvider Provider)
+{
+	switch (Provider)
+	{
+	case ESafeSaveSourceControlProvider::Git:
+		return TEXT("Git");
+	case ESafeSaveSourceControlProvider::Plastic:
+		return TEXT("Plastic");
+	default:
+		return TEXT("None");
+	}
+}
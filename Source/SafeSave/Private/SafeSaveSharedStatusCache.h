@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "SafeSaveSourceControlStatus.h"
+
+class FJsonObject;
+
+/**
+ * Status result shared by every editor and commandlet working on the same project. The last result is kept
+ * as JSON under Saved/SafeSave; a system-wide lock (a lock file on Linux and Mac, a named mutex on Windows)
+ * makes the processes take turns, so while one of them runs git or cm the others wait and then read its
+ * result instead of repeating the same query. Called from the SafeSave worker thread.
+ */
+class FSafeSaveSharedStatusCache
+{
+public:
+	explicit FSafeSaveSharedStatusCache(const FString& InProjectDir);
+
+	/**
+	 * Reads the last published result. Succeeds only if it was produced with the same SettingsHash and its
+	 * query started at or after MinQueryStartUtc; older results may miss changes this process knows about.
+	 */
+	bool TryRead(uint32 SettingsHash, const FDateTime& MinQueryStartUtc, FSafeSaveSourceControlStatus& OutStatus) const;
+
+	/** Publishes a result; written to a temporary file and moved into place so readers never see a partial file. */
+	void Write(uint32 SettingsHash, const FDateTime& QueryStartUtc, const FSafeSaveSourceControlStatus& Status) const;
+
+	/**
+	 * Waits up to TimeoutSeconds for the cross-process lock, giving up early once CancelFlag is set.
+	 * Returns null if the lock could not be taken; the caller then queries without publishing.
+	 */
+	TUniquePtr<FSystemWideCriticalSection> Lock(double TimeoutSeconds, const TAtomic<bool>* CancelFlag) const;
+
+	/** The editor's last live status, kept across sessions so the toolbar has something to show before the first query. */
+	void WriteLastKnown(const FSafeSaveSourceControlStatus& Status) const;
+	/** Reads the status WriteLastKnown saved for this project; OutStatus is marked stale. */
+	bool ReadLastKnown(FSafeSaveSourceControlStatus& OutStatus) const;
+
+	/** Status (including the file index) as a JSON object, and back. */
+	static TSharedRef<FJsonObject> StatusToJson(const FSafeSaveSourceControlStatus& Status);
+	static bool StatusFromJson(const FJsonObject& Object, FSafeSaveSourceControlStatus& OutStatus);
+
+	static FString ProviderToString(ESafeSaveSourceControlProvider Provider);
+
+private:
+	FString ProjectDir;
+	FString CacheFilename;
+	FString LastKnownFilename;
+	FString LockName;
+};
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveStats.h"
+
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_SafeSave_Tick);
+DEFINE_STAT(STAT_SafeSave_UpdateUnsavedState);
+DEFINE_STAT(STAT_SafeSave_ReconcileDirtyPackages);
+DEFINE_STAT(STAT_SafeSave_RefreshPresentation);
+DEFINE_STAT(STAT_SafeSave_ApplyStatus);
+
+DEFINE_STAT(STAT_SafeSave_StatusQuery);
+DEFINE_STAT(STAT_SafeSave_GitStatus);
+DEFINE_STAT(STAT_SafeSave_PlasticStatus);
+DEFINE_STAT(STAT_SafeSave_RunProcess);
+DEFINE_STAT(STAT_SafeSave_PlasticShellCommand);
+DEFINE_STAT(STAT_SafeSave_ParseGitStatus);
+DEFINE_STAT(STAT_SafeSave_ParsePlasticStatus);
+DEFINE_STAT(STAT_SafeSave_BuildFileIndex);
+DEFINE_STAT(STAT_SafeSave_ClearUnchangedPackages);
+
+DEFINE_STAT(STAT_SafeSave_StatusQueries);
+DEFINE_STAT(STAT_SafeSave_ProcessSpawns);
+DEFINE_STAT(STAT_SafeSave_ShellCommands);
+DEFINE_STAT(STAT_SafeSave_ProcessWallTime);
+DEFINE_STAT(STAT_SafeSave_ParsedEntries);
+
+DEFINE_STAT(STAT_SafeSave_DirtyPackages);
+DEFINE_STAT(STAT_SafeSave_IndexedPackages);
+
+TRACE_DECLARE_INT_COUNTER(SafeSave_StatusQueries, TEXT("SafeSave/StatusQueries"));
+TRACE_DECLARE_INT_COUNTER(SafeSave_ProcessSpawns, TEXT("SafeSave/ProcessSpawns"));
+TRACE_DECLARE_INT_COUNTER(SafeSave_ShellCommands, TEXT("SafeSave/ShellCommands"));
+TRACE_DECLARE_FLOAT_COUNTER(SafeSave_ProcessWallTime, TEXT("SafeSave/ProcessWallTimeMs"));
+TRACE_DECLARE_INT_COUNTER(SafeSave_ParsedEntries, TEXT("SafeSave/ParsedEntries"));
+TRACE_DECLARE_INT_COUNTER(SafeSave_DirtyPackages, TEXT("SafeSave/DirtyPackages"));
+TRACE_DECLARE_INT_COUNTER(SafeSave_IndexedPackages, TEXT("SafeSave/IndexedPackages"));
+
+void FSafeSaveStats::RecordProcess(double WallSeconds, bool bSpawned)
+{
+	const float WallMs = (float)(WallSeconds * 1000.0);
+	INC_FLOAT_STAT_BY(STAT_SafeSave_ProcessWallTime, WallMs);
+	TRACE_COUNTER_ADD(SafeSave_ProcessWallTime, WallMs);
+
+	if (bSpawned)
+	{
+		INC_DWORD_STAT(STAT_SafeSave_ProcessSpawns);
+		TRACE_COUNTER_INCREMENT(SafeSave_ProcessSpawns);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_SafeSave_ShellCommands);
+		TRACE_COUNTER_INCREMENT(SafeSave_ShellCommands);
+	}
+}
+
+void FSafeSaveStats::RecordStatusQuery()
+{
+	INC_DWORD_STAT(STAT_SafeSave_StatusQueries);
+	TRACE_COUNTER_INCREMENT(SafeSave_StatusQueries);
+}
+
+void FSafeSaveStats::RecordParsedEntries(int32 Num)
+{
+	INC_DWORD_STAT_BY(STAT_SafeSave_ParsedEntries, Num);
+	TRACE_COUNTER_ADD(SafeSave_ParsedEntries, Num);
+}
+
+void FSafeSaveStats::SetDirtyPackages(int32 Num)
+{
+	SET_DWORD_STAT(STAT_SafeSave_DirtyPackages, Num);
+	TRACE_COUNTER_SET(SafeSave_DirtyPackages, Num);
+}
+
+void FSafeSaveStats::SetIndexedPackages(int32 Num)
+{
+	SET_DWORD_STAT(STAT_SafeSave_IndexedPackages, Num);
+	TRACE_COUNTER_SET(SafeSave_IndexedPackages, Num);
+}
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("SafeSave"), STATGROUP_SafeSave, STATCAT_Advanced);
+
+// Game thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_SafeSave_Tick, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Unsaved State"), STAT_SafeSave_UpdateUnsavedState, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reconcile Dirty Packages"), STAT_SafeSave_ReconcileDirtyPackages, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Refresh Presentation"), STAT_SafeSave_RefreshPresentation, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Status"), STAT_SafeSave_ApplyStatus, STATGROUP_SafeSave, );
+
+// Status worker
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Status Query"), STAT_SafeSave_StatusQuery, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Git Status"), STAT_SafeSave_GitStatus, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plastic Status"), STAT_SafeSave_PlasticStatus, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Process"), STAT_SafeSave_RunProcess, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("cm Shell Command"), STAT_SafeSave_PlasticShellCommand, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Git Status"), STAT_SafeSave_ParseGitStatus, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Plastic Status"), STAT_SafeSave_ParsePlasticStatus, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build File Index"), STAT_SafeSave_BuildFileIndex, STATGROUP_SafeSave, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Clear Unchanged Packages"), STAT_SafeSave_ClearUnchangedPackages, STATGROUP_SafeSave, );
+
+// Session totals
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Status Queries"), STAT_SafeSave_StatusQueries, STATGROUP_SafeSave, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Processes Spawned"), STAT_SafeSave_ProcessSpawns, STATGROUP_SafeSave, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("cm Shell Commands"), STAT_SafeSave_ShellCommands, STATGROUP_SafeSave, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Process Wall Time (ms)"), STAT_SafeSave_ProcessWallTime, STATGROUP_SafeSave, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Parsed Entries"), STAT_SafeSave_ParsedEntries, STATGROUP_SafeSave, );
+
+// Current values
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dirty Packages"), STAT_SafeSave_DirtyPackages, STATGROUP_SafeSave, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Indexed Packages"), STAT_SafeSave_IndexedPackages, STATGROUP_SafeSave, );
+
+/** Cycle stat for `stat SafeSave` plus a named CPU scope for Unreal Insights. */
+#define SAFESAVE_SCOPE(Stat, Name) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+
+/** Updates the non-cycle stats together with the matching Insights trace counters (SafeSave/...). */
+class FSafeSaveStats
+{
+public:
+	/** One child process run or cm shell command; bSpawned is false for commands sent to an existing shell. */
+	static void RecordProcess(double WallSeconds, bool bSpawned);
+	static void RecordStatusQuery();
+	static void RecordParsedEntries(int32 Num);
+	static void SetDirtyPackages(int32 Num);
+	static void SetIndexedPackages(int32 Num);
+};
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveStatusChecks.h"
+
+namespace
+{
+	bool IsUsable(const FSafeSaveSourceControlStatus& Status)
+	{
+		return Status.bClientAvailable && Status.bRepo;
+	}
+}
+
+bool FSafeSaveStatusChecks::CanPull(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets)
+{
+	return Status.Provider == ESafeSaveSourceControlProvider::Git && IsUsable(Status)
+		&& Status.bHasUpstream && Status.Behind > 0 && IsWorkingTreeClean(Status) && !bHasUnsavedAssets;
+}
+
+bool FSafeSaveStatusChecks::CanPush(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets)
+{
+	return Status.Provider == ESafeSaveSourceControlProvider::Git && IsUsable(Status)
+		&& Status.bHasUpstream && Status.Ahead > 0 && Status.Behind == 0 && IsWorkingTreeClean(Status) && !bHasUnsavedAssets;
+}
+
+bool FSafeSaveStatusChecks::CanUpdatePlastic(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets)
+{
+	return Status.Provider == ESafeSaveSourceControlProvider::Plastic && IsUsable(Status)
+		&& IsWorkingTreeClean(Status) && !bHasUnsavedAssets;
+}
+
+TArray<FString> FSafeSaveStatusChecks::Evaluate(const FSafeSaveSourceControlStatus& Status, int32 UnsavedAssetCount, const FOptions& Options)
+{
+	TArray<FString> Failures;
+
+	// Without a status none of the other checks mean anything, so an unknown state never passes.
+	if (!Status.bClientAvailable)
+	{
+		Failures.Add(TEXT("Git or cm client not found"));
+		return Failures;
+	}
+	if (Status.bAuthRequired)
+	{
+		Failures.Add(TEXT("Source control login required"));
+		return Failures;
+	}
+	if (!Status.bRepo)
+	{
+		Failures.Add(Status.LastError.IsEmpty() ? TEXT("Not a repository or workspace") : Status.LastError);
+		return Failures;
+	}
+	if (!Status.LastError.IsEmpty())
+	{
+		Failures.Add(Status.LastError);
+	}
+	if (Status.NestedRepositoriesFailed > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("%d nested repositories did not answer"), Status.NestedRepositoriesFailed));
+	}
+
+	if (Options.bRequireNoConflicts && Status.bHasConflicts)
+	{
+		Failures.Add(TEXT("Conflicts"));
+	}
+	if (Options.bRequireCleanTree && !IsWorkingTreeClean(Status))
+	{
+		Failures.Add(FString::Printf(TEXT("%d local changes"), Status.Staged + Status.Unstaged + Status.Untracked));
+	}
+	if (Options.bRequireUpToDate && Status.Behind > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("Behind upstream by %d"), Status.Behind));
+	}
+	if (Options.bRequireNoUnsavedAssets && UnsavedAssetCount > 0)
+	{
+		Failures.Add(FString::Printf(TEXT("%d unsaved assets"), UnsavedAssetCount));
+	}
+
+	return Failures;
+}
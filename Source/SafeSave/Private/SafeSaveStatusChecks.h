@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SafeSaveSourceControlStatus.h"
+
+/**
+ * The safety rules SafeSave applies to one status result: whether the toolbar may pull, push or update, and
+ * which build gate checks fail. Pure functions of the status, so the editor and the SafeSaveStatus commandlet
+ * apply exactly the same rules.
+ */
+class FSafeSaveStatusChecks
+{
+public:
+	/** Which checks a gate applies. */
+	struct FOptions
+	{
+		bool bRequireCleanTree = true;
+		bool bRequireNoConflicts = true;
+		bool bRequireUpToDate = true;
+		bool bRequireNoUnsavedAssets = true;
+	};
+
+	static bool IsWorkingTreeClean(const FSafeSaveSourceControlStatus& Status)
+	{
+		return Status.Staged + Status.Unstaged + Status.Untracked == 0;
+	}
+
+	static bool CanPull(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets);
+	static bool CanPush(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets);
+	static bool CanUpdatePlastic(const FSafeSaveSourceControlStatus& Status, bool bHasUnsavedAssets);
+
+	/** One short reason per failed check ("3 local changes", "Behind upstream by 2"); empty when the status passes. */
+	static TArray<FString> Evaluate(const FSafeSaveSourceControlStatus& Status, int32 UnsavedAssetCount, const FOptions& Options);
+};
@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveStatusCommandlet.h"
+
+#include "SafeSaveSharedStatusCache.h"
+#include "SafeSaveStatusChecks.h"
+#include "SafeSaveStatusService.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	enum : int32
+	{
+		ExitPassed = 0,
+		ExitFailed = 1,
+		ExitUsage = 2
+	};
+
+	void AddRoot(const FString& Root, TArray<FString>& Roots)
+	{
+		const FString Trimmed = Root.TrimStartAndEnd().TrimQuotes();
+		if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT("#")))
+		{
+			return;
+		}
+
+		FString FullPath = FPaths::ConvertRelativePathToFull(Trimmed);
+		FPaths::NormalizeDirectoryName(FullPath);
+		Roots.AddUnique(FullPath);
+	}
+
+	FString ToJsonString(const TSharedRef<FJsonObject>& Object, bool bCondensed)
+	{
+		FString Output;
+		if (bCondensed)
+		{
+			const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+			FJsonSerializer::Serialize(Object, Writer);
+		}
+		else
+		{
+			const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+			FJsonSerializer::Serialize(Object, Writer);
+		}
+		return Output;
+	}
+}
+
+USafeSaveStatusCommandlet::USafeSaveStatusCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USafeSaveStatusCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	TArray<FString> Roots;
+	if (const FString* RootList = ParamVals.Find(TEXT("Roots")))
+	{
+		TArray<FString> Entries;
+		RootList->ParseIntoArray(Entries, TEXT("+"), true);
+		for (const FString& Entry : Entries)
+		{
+			AddRoot(Entry, Roots);
+		}
+	}
+	if (const FString* RootsFile = ParamVals.Find(TEXT("RootsFile")))
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, **RootsFile))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SafeSave] Could not read roots file %s."), **RootsFile);
+			return ExitUsage;
+		}
+		for (const FString& Line : Lines)
+		{
+			AddRoot(Line, Roots);
+		}
+	}
+	if (Roots.Num() == 0)
+	{
+		AddRoot(FPaths::ProjectDir(), Roots);
+	}
+
+	// The editor's dirty packages are none of a build machine's business: nothing here has been edited.
+	FSafeSaveStatusChecks::FOptions Options;
+	Options.bRequireCleanTree = !Switches.Contains(TEXT("AllowChanges"));
+	Options.bRequireUpToDate = !Switches.Contains(TEXT("AllowBehind"));
+	Options.bRequireNoUnsavedAssets = false;
+
+	// Each root is a separate git or cm process tree, so the queries are bound by the processes, not by this
+	// thread; every query gets its own service instance so no detection or index cache is shared.
+	TArray<FSafeSaveSourceControlStatus> Statuses;
+	Statuses.SetNum(Roots.Num());
+	ParallelFor(Roots.Num(), [&Roots, &Statuses](int32 Index)
+	{
+		Statuses[Index] = FSafeSaveStatusService::QueryProjectStatus(Roots[Index]);
+	}, EParallelForFlags::Unbalanced);
+
+	bool bAllPassed = true;
+	TArray<TSharedPtr<FJsonValue>> RootValues;
+	for (int32 Index = 0; Index < Roots.Num(); ++Index)
+	{
+		const TArray<FString> Failures = FSafeSaveStatusChecks::Evaluate(Statuses[Index], 0, Options);
+		bAllPassed &= Failures.Num() == 0;
+
+		// The per-package file map is for the editor's overlays; a gate only needs the counts.
+		const TSharedRef<FJsonObject> StatusObject = FSafeSaveSharedStatusCache::StatusToJson(Statuses[Index]);
+		StatusObject->RemoveField(TEXT("files"));
+		StatusObject->RemoveField(TEXT("fileIndexChecksum"));
+
+		TArray<TSharedPtr<FJsonValue>> FailureValues;
+		for (const FString& Failure : Failures)
+		{
+			FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+		}
+
+		const TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+		RootObject->SetStringField(TEXT("root"), Roots[Index]);
+		RootObject->SetBoolField(TEXT("passed"), Failures.Num() == 0);
+		RootObject->SetArrayField(TEXT("failures"), FailureValues);
+		RootObject->SetObjectField(TEXT("status"), StatusObject);
+		RootValues.Add(MakeShared<FJsonValueObject>(RootObject));
+
+		UE_LOG(LogTemp, Display, TEXT("[SafeSave] %s: %s%s"), *Roots[Index], Failures.Num() == 0 ? TEXT("passed") : TEXT("failed - "), *FString::Join(Failures, TEXT(", ")));
+	}
+
+	const TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("passed"), bAllPassed);
+	Result->SetArrayField(TEXT("roots"), RootValues);
+
+	if (const FString* OutputPath = ParamVals.Find(TEXT("Output")))
+	{
+		if (!FFileHelper::SaveStringToFile(ToJsonString(Result, false), **OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[SafeSave] Could not write %s."), **OutputPath);
+			return ExitUsage;
+		}
+	}
+	UE_LOG(LogTemp, Display, TEXT("[SafeSave] %s"), *ToJsonString(Result, true));
+
+	return bAllPassed ? ExitPassed : ExitFailed;
+}
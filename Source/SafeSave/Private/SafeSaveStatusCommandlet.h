@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SafeSaveStatusCommandlet.generated.h"
+
+/**
+ * Headless SafeSave gate for CI and build farms: queries the status of one or more project roots in parallel,
+ * applies the same checks as the editor and prints the result as JSON.
+ *
+ *   UnrealEditor-Cmd.exe Project.uproject -run=SafeSaveStatus [-Roots=A+B] [-RootsFile=Roots.txt] [-Output=Status.json] [-AllowChanges] [-AllowBehind]
+ *
+ * Returns 0 when every root passes, 1 when any fails and 2 for invalid arguments.
+ */
+UCLASS()
+class USafeSaveStatusCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USafeSaveStatusCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,2087 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveStatusService.h"
+
+#include "SafeSaveAutoFetch.h"
+#include "SafeSaveCommandRunner.h"
+#include "SafeSaveDetectionCache.h"
+#include "SafeSaveDirtyPackageTracker.h"
+#include "SafeSaveEditorSourceControl.h"
+#include "SafeSaveGitRepository.h"
+#include "SafeSaveGitStatusParser.h"
+#include "SafeSaveGitStatusQuery.h"
+#include "SafeSaveLockTracker.h"
+#include "SafeSavePackageFilter.h"
+#include "SafeSavePackageReloader.h"
+#include "SafeSavePlasticStatusQuery.h"
+#include "SafeSavePollScheduler.h"
+#include "SafeSaveProcess.h"
+#include "SafeSaveRepositoryWatcher.h"
+#include "SafeSaveSettings.h"
+#include "SafeSaveSharedStatusCache.h"
+#include "SafeSaveStats.h"
+#include "SafeSaveStatusChecks.h"
+#include "SafeSaveUnchangedPackages.h"
+#include "SafeSaveWorker.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "ISourceControlModule.h"
+#include "ISourceControlProvider.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "PackagesDialog.h"
+#include "ShaderCompiler.h"
+#include "SourceControlOperations.h"
+#include "Styling/AppStyle.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "SafeSaveToolbar"
+
+namespace
+{
+	FString TrimCopy(const FString& InText)
+	{
+		FString OutText = InText;
+		OutText.TrimStartAndEndInline();
+		return OutText;
+	}
+
+	// Git rewrites several metadata files per operation; wait for them to settle before refreshing.
+	constexpr double RepositoryChangeSettleSeconds = 0.25;
+
+	// The deferred first query waits this long after startup work stops, and never longer than the cap in total.
+	constexpr double StartupSettleSeconds = 2.0;
+	constexpr double StartupRefreshMaxDelaySeconds = 120.0;
+
+	/** Everything a consumer can observe except the refresh timestamp, which moves on every poll. */
+	bool HasSameContent(const FSafeSaveSourceControlStatus& A, const FSafeSaveSourceControlStatus& B)
+	{
+		const bool bSameIndex = A.FileIndex == B.FileIndex
+			|| (A.FileIndex.IsValid() && B.FileIndex.IsValid() && A.FileIndex->GetChecksum() == B.FileIndex->GetChecksum() && A.FileIndex->Num() == B.FileIndex->Num());
+
+		return bSameIndex
+			&& A.Provider == B.Provider
+			&& A.bClientAvailable == B.bClientAvailable
+			&& A.bRepo == B.bRepo
+			&& A.bAuthRequired == B.bAuthRequired
+			&& A.bHasUpstream == B.bHasUpstream
+			&& A.bHasConflicts == B.bHasConflicts
+			&& A.Ahead == B.Ahead
+			&& A.Behind == B.Behind
+			&& A.Staged == B.Staged
+			&& A.Unstaged == B.Unstaged
+			&& A.Untracked == B.Untracked
+			&& A.Branch == B.Branch
+			&& A.HeadCommit == B.HeadCommit
+			&& A.UpstreamCommit == B.UpstreamCommit
+			&& A.RepoRoot == B.RepoRoot
+			&& A.WorkspaceName == B.WorkspaceName
+			&& A.LastError == B.LastError
+			&& A.ScanMode == B.ScanMode
+			&& A.EditorProviderName == B.EditorProviderName
+			&& A.NestedRepositories == B.NestedRepositories
+			&& A.NestedRepositoriesFailed == B.NestedRepositoriesFailed
+			&& A.bStale == B.bStale;
+	}
+}
+
+struct FSafeSaveStatusService::FNestedStatusBatch
+{
+	struct FResult
+	{
+		explicit FResult(const FNestedRepository& InRepository)
+			: Repository(InRepository)
+			, Builder(InRepository.Root)
+		{
+		}
+
+		FNestedRepository Repository;
+		FSafeSaveSourceControlStatus Status;
+		FSafeSaveFileStatusIndex::FBuilder Builder;
+		TUniquePtr<FSafeSaveGitStatusParser> Parser;
+		TArray<uint8> PlasticOutput;
+		int32 ProcessIndex = INDEX_NONE;
+	};
+
+	void Reset()
+	{
+		Group.Reset();
+		Results.Reset();
+		RepoRoot.Reset();
+	}
+
+	FString RepoRoot;
+	/** Declared after Results so it is destroyed (killing stray processes) before the parsers it feeds. */
+	TArray<TUniquePtr<FResult>> Results;
+	TUniquePtr<FSafeSaveProcessGroup> Group;
+};
+
+FSafeSaveStatusService::FSafeSaveStatusService()
+	: CommandRunner(MakeUnique<FSafeSaveCommandRunner>())
+	, DetectionCache(MakeUnique<FSafeSaveDetectionCache>())
+{
+	GitQuery = MakeUnique<FSafeSaveGitStatusQuery>(*CommandRunner, *DetectionCache);
+	PlasticQuery = MakeUnique<FSafeSavePlasticStatusQuery>(*CommandRunner, *DetectionCache);
+	LockTracker = MakeUnique<FSafeSaveLockTracker>(*CommandRunner);
+	AutoFetch = MakeUnique<FSafeSaveAutoFetch>(*CommandRunner, *GitQuery);
+
+	// Set before any query runs; called from InvalidateDetectionCache and when a query finds a cached root stale.
+	DetectionCache->SetOnInvalidated([this]()
+	{
+		{
+			FScopeLock Lock(&NestedCacheLock);
+			NestedRepositoryCache = FNestedRepositoryCache();
+		}
+		// The repository's core.* settings are read again with the next detection; the git version is not.
+		GitQuery->ResetRepositoryConfig();
+		LockTracker->ResetUserName();
+	});
+}
+
+FSafeSaveStatusService::~FSafeSaveStatusService()
+{
+	Shutdown();
+}
+
+void FSafeSaveStatusService::Initialize()
+{
+	// Cooks, resaves and DDC fills have no toolbar to feed, so nothing is watched, polled or queried there. The
+	// SafeSaveStatus commandlet does not need the service either; it queries through QueryProjectStatus.
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
+	AutoFetch->Start(FPlatformTime::Seconds());
+
+	PlasticQuery->StartShell();
+	PollScheduler = MakeUnique<FSafeSavePollScheduler>();
+	Worker = MakeUnique<FSafeSaveWorker>();
+	SharedStatusCache = MakeUnique<FSafeSaveSharedStatusCache>(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+	RepositoryWatcher = MakeUnique<FSafeSaveRepositoryWatcher>();
+	RepositoryWatcher->OnRepositoryChanged().AddRaw(this, &FSafeSaveStatusService::HandleRepositoryChanged);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FSafeSaveStatusService::HandlePackageSaved);
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FSafeSaveStatusService::HandlePackageMarkedDirty);
+	ProviderChangedHandle = ISourceControlModule::Get().RegisterProviderChanged(FSourceControlProviderChanged::FDelegate::CreateRaw(this, &FSafeSaveStatusService::HandleSourceControlProviderChanged));
+	SourceControlStateChangedHandle = ISourceControlModule::Get().GetProvider().RegisterSourceControlStateChanged_Handle(FSourceControlStateChanged::FDelegate::CreateRaw(this, &FSafeSaveStatusService::HandleSourceControlStateChanged));
+	PackageFilter = FSafeSavePackageFilter::Create(GetDefault<USafeSaveSettings>());
+	SettingsChangedHandle = GetMutableDefault<USafeSaveSettings>()->OnSettingChanged().AddRaw(this, &FSafeSaveStatusService::HandleSettingsChanged);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FSafeSaveStatusService::Tick), 0.5f);
+
+	UpdateUnsavedState();
+	RefreshPresentation();
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (Settings && Settings->bDeferStartupRefresh)
+	{
+		bStartupRefreshPending = true;
+		StartupSeconds = FPlatformTime::Seconds();
+		bEngineInitComplete = GIsRunning;
+		if (!bEngineInitComplete)
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FSafeSaveStatusService::HandlePostEngineInit);
+		}
+		RestoreLastKnownStatus();
+		return;
+	}
+
+	RequestSourceControlStatusUpdate(true);
+}
+
+void FSafeSaveStatusService::RestoreLastKnownStatus()
+{
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+	Worker->Enqueue([SelfWeak]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		FSafeSaveSourceControlStatus LastKnown;
+		if (!Pinned.IsValid() || !Pinned->SharedStatusCache->ReadLastKnown(LastKnown))
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, LastKnown]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			// A live result that arrived first (e.g. a refresh the user asked for) wins.
+			if (PinnedGame.IsValid() && !PinnedGame->bIsShutDown && PinnedGame->GetStatusSnapshot().LastUpdateUtc == FDateTime())
+			{
+				PinnedGame->PublishSnapshot(LastKnown);
+				PinnedGame->RefreshPresentation();
+				PinnedGame->StatusUpdatedEvent.Broadcast();
+			}
+		});
+	});
+}
+
+bool FSafeSaveStatusService::IsEditorStartupComplete(double NowSeconds)
+{
+	if (NowSeconds - StartupSeconds >= StartupRefreshMaxDelaySeconds)
+	{
+		return true;
+	}
+
+	const IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	const bool bBusy = !bEngineInitComplete
+		|| (AssetRegistry && AssetRegistry->IsLoadingAssets())
+		|| (GShaderCompilingManager && GShaderCompilingManager->IsCompiling());
+	if (bBusy)
+	{
+		StartupIdleSinceSeconds = 0.0;
+		return false;
+	}
+
+	if (StartupIdleSinceSeconds == 0.0)
+	{
+		StartupIdleSinceSeconds = NowSeconds;
+	}
+	return NowSeconds - StartupIdleSinceSeconds >= StartupSettleSeconds;
+}
+
+void FSafeSaveStatusService::HandlePostEngineInit()
+{
+	bEngineInitComplete = true;
+}
+
+void FSafeSaveStatusService::Shutdown()
+{
+	if (bIsShutDown)
+	{
+		return;
+	}
+
+	bIsShutDown = true;
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	if (ISourceControlModule* SourceControlModule = FModuleManager::GetModulePtr<ISourceControlModule>("SourceControl"))
+	{
+		SourceControlModule->UnregisterProviderChanged(ProviderChangedHandle);
+		SourceControlModule->GetProvider().UnregisterSourceControlStateChanged_Handle(SourceControlStateChangedHandle);
+	}
+	if (AssetOpenedHandle.IsValid() && GEditor)
+	{
+		if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+		{
+			AssetEditorSubsystem->OnAssetOpenedInEditor().Remove(AssetOpenedHandle);
+		}
+	}
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<USafeSaveSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
+	RepositoryWatcher.Reset();
+	DirtyPackageTracker.Reset();
+	if (Worker.IsValid())
+	{
+		// Queued jobs are dropped and the running one is cancelled, which kills its process.
+		CommandRunner->Cancel();
+		Worker->StopAndWait();
+	}
+	PlasticQuery->StopShell();
+	StatusUpdatedEvent.Clear();
+	StatusChangedEvent.Clear();
+}
+
+bool FSafeSaveStatusService::Tick(float DeltaTime)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_Tick, FSafeSaveStatusService::Tick);
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const double GitInterval = GetBaseStatusInterval();
+
+	if (bStartupRefreshPending)
+	{
+		if (!IsEditorStartupComplete(NowSeconds))
+		{
+			// Nothing runs while the editor is still starting; the toolbar shows the last session's status.
+			return true;
+		}
+
+		bStartupRefreshPending = false;
+		RequestSourceControlStatusUpdate(true);
+		LastSourceControlCheckSeconds = NowSeconds;
+		LockTracker->SetLastRefreshSeconds(NowSeconds);
+	}
+
+	// Coming back from the background, PIE or idle: poll now rather than waiting out the stretched interval.
+	if (PollScheduler->Update(NowSeconds, Settings))
+	{
+		PollScheduler->ResetBackoff();
+		if (!bStatusUpdateInFlight.Load() && NowSeconds - LastSourceControlCheckSeconds >= GitInterval)
+		{
+			RequestSourceControlStatusUpdate(true);
+			LastSourceControlCheckSeconds = NowSeconds;
+		}
+	}
+
+	if (bCoalescedRefreshRequested)
+	{
+		bCoalescedRefreshRequested = false;
+		RequestSourceControlStatusUpdate();
+		LastSourceControlCheckSeconds = NowSeconds;
+	}
+
+	if (bEditorStatesChanged && !bStatusUpdateInFlight.Load() && !GetStatusSnapshot().EditorProviderName.IsEmpty())
+	{
+		const FString ProviderName = GetEditorStatusProviderName();
+		bEditorStatesChanged = false;
+		if (!ProviderName.IsEmpty())
+		{
+			bStatusUpdateInFlight = true;
+			StatusStartedGeneration = StatusRequestGeneration;
+			StartEditorProviderStatusUpdate(ProviderName, false);
+		}
+	}
+
+	const double DirtyInterval = PollScheduler->ScaleInterval(Settings ? FMath::Max(0.1, (double)Settings->DirtyCheckIntervalSeconds) : 1.0);
+
+	if (NowSeconds - LastDirtyCheckSeconds >= DirtyInterval)
+	{
+		UpdateUnsavedState();
+		LastDirtyCheckSeconds = NowSeconds;
+	}
+
+	const bool bWatching = Settings && RepositoryWatcher.IsValid() && RepositoryWatcher->IsWatching();
+	const double PollInterval = PollScheduler->GetStatusInterval(bWatching ? FMath::Max(GitInterval, (double)Settings->WatcherSafetyNetIntervalSeconds) : GitInterval);
+
+	if (bRepositoryChangePending && !bStatusUpdateInFlight.Load() && NowSeconds - LastRepositoryChangeSeconds >= RepositoryChangeSettleSeconds)
+	{
+		// The change was stamped when it was observed, so a result another editor queried after it still counts.
+		bRepositoryChangePending = false;
+		RequestSourceControlStatusUpdate(true);
+		LastSourceControlCheckSeconds = NowSeconds;
+	}
+	else if (NowSeconds - LastSourceControlCheckSeconds >= PollInterval)
+	{
+		RequestSourceControlStatusUpdate(true);
+		LastSourceControlCheckSeconds = NowSeconds;
+	}
+
+	// The asset editor subsystem only exists once the editor engine is up, after this module has started.
+	if (!AssetOpenedHandle.IsValid() && GEditor)
+	{
+		if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+		{
+			AssetOpenedHandle = AssetEditorSubsystem->OnAssetOpenedInEditor().AddRaw(this, &FSafeSaveStatusService::HandleAssetOpened);
+		}
+	}
+
+	if (Settings && Settings->bQueryLocks && NowSeconds - LockTracker->GetLastRefreshSeconds() >= PollScheduler->ScaleInterval(FMath::Max(30.0, (double)Settings->LockRefreshIntervalSeconds)))
+	{
+		RequestLockRefresh();
+	}
+
+	if (Settings && Settings->bAutoFetch && IsGitProvider())
+	{
+		const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+		const bool bCanAutoFetch = Status.bClientAvailable && Status.bRepo && !bStatusUpdateInFlight.Load();
+
+		bool bFullFetch = false;
+		if (bCanAutoFetch && AutoFetch->ConsumeDueFetch(NowSeconds, *Settings, *PollScheduler, bFullFetch))
+		{
+			RunAutoFetchAsync(bFullFetch);
+		}
+	}
+
+	return true;
+}
+
+double FSafeSaveStatusService::GetBaseStatusInterval() const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	return Settings ? FMath::Max(1.0, (double)Settings->GitCheckIntervalSeconds) : 5.0;
+}
+
+void FSafeSaveStatusService::UpdateUnsavedState()
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_UpdateUnsavedState, FSafeSaveStatusService::UpdateUnsavedState);
+
+	const int32 PreviousCount = UnsavedAssetCount;
+	const FString PreviousSample = SampleUnsavedPackage;
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const bool bEventDriven = Settings && Settings->bEventDrivenDirtyTracking;
+
+	if (bEventDriven)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		if (!DirtyPackageTracker.IsValid())
+		{
+			DirtyPackageTracker = MakeUnique<FSafeSaveDirtyPackageTracker>(PackageFilter.ToSharedRef());
+			LastDirtyReconcileSeconds = NowSeconds;
+		}
+		else if (NowSeconds - LastDirtyReconcileSeconds >= FMath::Max(5.0, (double)Settings->DirtyReconcileIntervalSeconds))
+		{
+			DirtyPackageTracker->Reconcile();
+			LastDirtyReconcileSeconds = NowSeconds;
+		}
+
+		UnsavedAssetCount = DirtyPackageTracker->GetDirtyPackageCount();
+		bHasUnsavedAssets = UnsavedAssetCount > 0;
+		SampleUnsavedPackage = DirtyPackageTracker->GetSamplePackageName();
+	}
+	else
+	{
+		DirtyPackageTracker.Reset();
+
+		TArray<UPackage*> DirtyPackages;
+		FEditorFileUtils::GetDirtyPackages(DirtyPackages);
+
+		UnsavedAssetCount = 0;
+		SampleUnsavedPackage.Reset();
+		for (const UPackage* Package : DirtyPackages)
+		{
+			if (PackageFilter->ShouldCount(Package))
+			{
+				if (UnsavedAssetCount++ == 0)
+				{
+					SampleUnsavedPackage = Package->GetName();
+				}
+			}
+		}
+		bHasUnsavedAssets = UnsavedAssetCount > 0;
+	}
+
+	FSafeSaveStats::SetDirtyPackages(UnsavedAssetCount);
+
+	if (UnsavedAssetCount != PreviousCount || SampleUnsavedPackage != PreviousSample)
+	{
+		PublishSnapshot(GetStatusSnapshot());
+		RefreshPresentation();
+		StatusUpdatedEvent.Broadcast();
+	}
+}
+
+void FSafeSaveStatusService::RequestSourceControlStatusUpdate(bool bAcceptSharedResult)
+{
+	if (!bAcceptSharedResult)
+	{
+		LastStatusInvalidationUtc = FDateTime::UtcNow();
+	}
+
+	++StatusRequestGeneration;
+	if (bStatusUpdateInFlight.Load())
+	{
+		// The running query may have read the repository before whatever prompted this request; the
+		// completion handler starts one follow-up for all requests that arrived in the meantime.
+		return;
+	}
+
+	StartSourceControlStatusUpdate();
+}
+
+void FSafeSaveStatusService::RefreshAll()
+{
+	if (PollScheduler.IsValid())
+	{
+		PollScheduler->ResetBackoff();
+	}
+	InvalidateDetectionCache();
+	UpdateUnsavedState();
+	RequestSourceControlStatusUpdate();
+}
+
+void FSafeSaveStatusService::ResetAutoFetchTimer()
+{
+	AutoFetch->ResetTimer(FPlatformTime::Seconds());
+}
+
+void FSafeSaveStatusService::SaveAll()
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	TGuardValue<bool> SaveAllGuard(bSaveAllInProgress, true);
+
+	if (Settings && Settings->bSkipUnchangedOnSaveAll)
+	{
+		SaveConfirmedChangedPackages();
+	}
+	else
+	{
+		// The engine's batch save handles checkout prompts and its own progress dialog.
+		FEditorFileUtils::SaveDirtyPackages(true, true, true, false, false, false);
+	}
+
+	UpdateUnsavedState();
+	RequestSourceControlStatusUpdate();
+	LastSourceControlCheckSeconds = FPlatformTime::Seconds();
+}
+
+void FSafeSaveStatusService::SaveConfirmedChangedPackages()
+{
+	TArray<UPackage*> DirtyPackages;
+	FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+	FEditorFileUtils::GetDirtyWorldPackages(DirtyPackages);
+	if (DirtyPackages.Num() == 0)
+	{
+		return;
+	}
+
+	// The same prompt the engine shows, asked first so only the packages the user chose are compared; a cancel
+	// leaves every dirty flag alone.
+	FPackagesDialogModule& PackagesDialogModule = FModuleManager::LoadModuleChecked<FPackagesDialogModule>(TEXT("PackagesDialog"));
+	PackagesDialogModule.CreatePackagesDialog(
+		LOCTEXT("SaveContentTitle", "Save Content"),
+		LOCTEXT("SaveContentMessage", "Select Content to Save. Selected packages that match their file on disk are not rewritten."));
+	PackagesDialogModule.AddButton(DRT_Save, LOCTEXT("SaveSelected", "Save Selected"), LOCTEXT("SaveSelectedTooltip", "Save the selected packages"));
+	PackagesDialogModule.AddButton(DRT_Cancel, LOCTEXT("Cancel", "Cancel"), LOCTEXT("CancelTooltip", "Do not save anything"));
+	for (UPackage* Package : DirtyPackages)
+	{
+		PackagesDialogModule.AddPackageItem(Package, ECheckBoxState::Checked);
+	}
+	if (PackagesDialogModule.ShowPackagesDialog() != DRT_Save)
+	{
+		return;
+	}
+
+	TArray<UPackage*> ConfirmedPackages;
+	PackagesDialogModule.GetResults(ConfirmedPackages, ECheckBoxState::Checked);
+	if (ConfirmedPackages.Num() == 0)
+	{
+		return;
+	}
+
+	const FSafeSaveUnchangedPackages::FResult Result = FSafeSaveUnchangedPackages::ClearUnchanged(ConfirmedPackages);
+	if (Result.bCancelled)
+	{
+		return;
+	}
+	if (Result.NumSkipped > 0)
+	{
+		Notify(FText::Format(LOCTEXT("SkippedUnchangedPackages", "{0} unchanged package(s) were not rewritten."), Result.NumSkipped), true);
+	}
+
+	if (Result.ChangedPackages.Num() > 0)
+	{
+		// Already confirmed once, so only checkout prompts remain.
+		FEditorFileUtils::PromptForCheckoutAndSave(Result.ChangedPackages, true, false);
+	}
+}
+
+void FSafeSaveStatusService::StartSourceControlStatusUpdate()
+{
+	bStatusUpdateInFlight = true;
+	StatusStartedGeneration = StatusRequestGeneration;
+
+	const FString EditorProviderName = GetEditorStatusProviderName();
+	if (!EditorProviderName.IsEmpty())
+	{
+		StartEditorProviderStatusUpdate(EditorProviderName, true);
+		return;
+	}
+
+	// Captured on the game thread; the shared result must be younger than the max age and than any local change.
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const bool bShareStatus = Settings && Settings->bShareStatusAcrossProcesses && SharedStatusCache.IsValid();
+	const uint32 SettingsHash = GetSharedStatusSettingsHash();
+	const FDateTime MaxAgeStartUtc = FDateTime::UtcNow() - FTimespan::FromSeconds(Settings ? FMath::Max(1.0, (double)Settings->SharedStatusMaxAgeSeconds) : 10.0);
+	const FDateTime MinSharedQueryStartUtc = FMath::Max(MaxAgeStartUtc, LastStatusInvalidationUtc);
+
+	const ESafeSaveSourceControlProvider PreferredProvider = GetPreferredProvider();
+
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+	const bool bQueued = Worker->Enqueue([SelfWeak, bShareStatus, SettingsHash, MinSharedQueryStartUtc, PreferredProvider]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+		FSafeSaveSourceControlStatus NewStatus;
+		bool bFromSharedCache = false;
+		TUniquePtr<FSystemWideCriticalSection> SharedLock;
+
+		if (bShareStatus)
+		{
+			bFromSharedCache = Pinned->SharedStatusCache->TryRead(SettingsHash, MinSharedQueryStartUtc, NewStatus);
+			if (!bFromSharedCache)
+			{
+				// Another process may be running this very query; wait for it and take its result.
+				const FSafeSaveProcess::FLimits Limits = Pinned->CommandRunner->GetProcessLimits(false);
+				SharedLock = Pinned->SharedStatusCache->Lock(Limits.TimeoutSeconds, Limits.CancelFlag);
+				bFromSharedCache = SharedLock.IsValid() && Pinned->SharedStatusCache->TryRead(SettingsHash, MinSharedQueryStartUtc, NewStatus);
+			}
+		}
+
+		if (!bFromSharedCache)
+		{
+			SAFESAVE_SCOPE(STAT_SafeSave_StatusQuery, FSafeSaveStatusService::StatusQuery);
+			FSafeSaveStats::RecordStatusQuery();
+
+			const FDateTime QueryStartUtc = FDateTime::UtcNow();
+			NewStatus = Pinned->QuerySourceControlStatus(ProjectDir, PreferredProvider);
+			NewStatus.LastUpdateUtc = FDateTime::UtcNow();
+
+			if (SharedLock.IsValid() && !Pinned->CommandRunner->IsCancelled())
+			{
+				Pinned->SharedStatusCache->Write(SettingsHash, QueryStartUtc, NewStatus);
+			}
+		}
+		SharedLock.Reset();
+
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, NewStatus]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (PinnedGame.IsValid() && !PinnedGame->bIsShutDown)
+			{
+				PinnedGame->ApplySourceControlStatus(NewStatus);
+			}
+		});
+	});
+
+	if (!bQueued)
+	{
+		bStatusUpdateInFlight = false;
+	}
+}
+
+void FSafeSaveStatusService::ApplySourceControlStatus(const FSafeSaveSourceControlStatus& NewStatus)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_ApplyStatus, FSafeSaveStatusService::ApplyStatus);
+	FSafeSaveStats::SetIndexedPackages(NewStatus.FileIndex.IsValid() ? NewStatus.FileIndex->Num() : 0);
+
+	PublishSnapshot(NewStatus);
+	bStatusUpdateInFlight = false;
+	// Not being in a repository at all is also treated as a failure, so non-versioned projects settle on the slow rate.
+	const bool bQuerySucceeded = NewStatus.bClientAvailable && NewStatus.bRepo && !NewStatus.bAuthRequired && NewStatus.LastError.IsEmpty();
+	PollScheduler->RecordStatusResult(bQuerySucceeded, GetBaseStatusInterval(), GetDefault<USafeSaveSettings>());
+	UpdateRepositoryWatcher();
+	RefreshPresentation();
+	StatusUpdatedEvent.Broadcast();
+
+	if (bIndexChangedDuringStatus)
+	{
+		bIndexChangedDuringStatus = false;
+		HandleRepositoryChanged(true);
+	}
+
+	if (StatusRequestGeneration != StatusStartedGeneration)
+	{
+		StartSourceControlStatusUpdate();
+		LastSourceControlCheckSeconds = FPlatformTime::Seconds();
+	}
+}
+
+void FSafeSaveStatusService::PublishSnapshot(const FSafeSaveSourceControlStatus& Status)
+{
+	check(IsInGameThread());
+
+	// Status may be a reference into the current snapshot (UpdateUnsavedState republishes it with a new
+	// unsaved count), so the old snapshot is kept alive until this function is done with it.
+	const FSafeSaveStatusSnapshotRef PreviousSnapshot = CurrentSnapshot;
+
+	// The new snapshot is built completely before it replaces the current one; readers see either, never a mix.
+	const bool bStatusChanged = !HasSameContent(PreviousSnapshot->Status, Status);
+	const bool bChanged = PreviousSnapshot->Version == 0 || bStatusChanged || PreviousSnapshot->UnsavedAssetCount != UnsavedAssetCount;
+
+	const TSharedRef<FSafeSaveStatusSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSafeSaveStatusSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Version = PreviousSnapshot->Version + (bChanged ? 1 : 0);
+	NewSnapshot->Status = Status;
+	NewSnapshot->UnsavedAssetCount = UnsavedAssetCount;
+
+	{
+		FScopeLock Lock(&SnapshotLock);
+		CurrentSnapshot = NewSnapshot;
+	}
+
+	if (bChanged)
+	{
+		StatusChangedEvent.Broadcast(*NewSnapshot);
+	}
+
+	// Live results are kept for the next session; the file is only rewritten when the status changed.
+	if (bStatusChanged && !Status.bStale && Status.LastUpdateUtc != FDateTime() && Worker.IsValid())
+	{
+		TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+		Worker->Enqueue([SelfWeak, NewSnapshot]()
+		{
+			if (TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin())
+			{
+				Pinned->SharedStatusCache->WriteLastKnown(NewSnapshot->Status);
+			}
+		});
+	}
+}
+
+FSafeSaveStatusSnapshotRef FSafeSaveStatusService::GetPublishedSnapshot() const
+{
+	// Only the game thread replaces the pointer, so it can read it without the lock.
+	if (IsInGameThread())
+	{
+		return CurrentSnapshot;
+	}
+
+	FScopeLock Lock(&SnapshotLock);
+	return CurrentSnapshot;
+}
+
+FString FSafeSaveStatusService::GetEditorStatusProviderName() const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings || Settings->StatusSource != ESafeSaveStatusSource::EditorProvider)
+	{
+		return FString();
+	}
+	return FSafeSaveEditorSourceControl::GetAvailableProviderName();
+}
+
+void FSafeSaveStatusService::StartEditorProviderStatusUpdate(const FString& ProviderName, bool bRunUpdate)
+{
+	bEditorUpdatePending = true;
+	if (!bRunUpdate)
+	{
+		FinishEditorProviderStatusUpdate(ProviderName);
+		return;
+	}
+
+	FSafeSaveStats::RecordStatusQuery();
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	const TArray<FString> Paths = FSafeSaveEditorSourceControl::GetUpdatePaths(GetDefault<USafeSaveSettings>(), ProjectDir);
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+
+	// The provider runs the update on its own worker and completes on the game thread.
+	const ECommandResult::Type Result = ISourceControlModule::Get().GetProvider().Execute(
+		ISourceControlOperation::Create<FUpdateStatus>(),
+		Paths,
+		EConcurrency::Asynchronous,
+		FSourceControlOperationComplete::CreateLambda([SelfWeak, ProviderName](const FSourceControlOperationRef& Operation, ECommandResult::Type InResult)
+		{
+			TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+			if (Pinned.IsValid() && !Pinned->bIsShutDown)
+			{
+				Pinned->FinishEditorProviderStatusUpdate(ProviderName);
+			}
+		}));
+
+	if (Result == ECommandResult::Failed)
+	{
+		// Whatever the provider has cached is still better than nothing.
+		FinishEditorProviderStatusUpdate(ProviderName);
+	}
+}
+
+void FSafeSaveStatusService::FinishEditorProviderStatusUpdate(const FString& ProviderName)
+{
+	if (!bEditorUpdatePending)
+	{
+		return;
+	}
+	bEditorUpdatePending = false;
+	bEditorStatesChanged = false;
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	FSafeSaveSourceControlStatus NewStatus;
+	FSafeSaveFileStatusIndex::FBuilder IndexBuilder(ProjectDir);
+	const TSharedRef<FSafeSaveLockIndex, ESPMode::ThreadSafe> Locks = MakeShared<FSafeSaveLockIndex, ESPMode::ThreadSafe>();
+	FSafeSaveEditorSourceControl::BuildStatusFromCache(ProviderName, ProjectDir, NewStatus, IndexBuilder, *Locks);
+	NewStatus.FileIndex = DetectionCache->ResolveFileIndex(NewStatus.RepoRoot, IndexBuilder);
+	NewStatus.LastUpdateUtc = FDateTime::UtcNow();
+	LockTracker->SetLockIndex(Locks);
+
+	if (NewStatus.Provider != ESafeSaveSourceControlProvider::Git)
+	{
+		ApplySourceControlStatus(NewStatus);
+		return;
+	}
+
+	// Branch and commit-level ahead/behind come from .git in-process; rev-list only runs when a commit moved.
+	NewStatus.Behind = 0;
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+	const bool bQueued = Worker->Enqueue([SelfWeak, NewStatus]() mutable
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		FSafeSaveGitRepository::FHeadInfo Head;
+		if (FSafeSaveGitRepository::ReadHead(NewStatus.RepoRoot, Head))
+		{
+			NewStatus.Branch = Head.Branch;
+			NewStatus.HeadCommit = Head.HeadOid;
+			NewStatus.UpstreamCommit = Head.UpstreamOid;
+			NewStatus.bHasUpstream = Head.bHasUpstream;
+			if (Head.bHasUpstream)
+			{
+				Pinned->GitQuery->UpdateAheadBehind(NewStatus);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, NewStatus]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (PinnedGame.IsValid() && !PinnedGame->bIsShutDown)
+			{
+				PinnedGame->ApplySourceControlStatus(NewStatus);
+			}
+		});
+	});
+
+	if (!bQueued)
+	{
+		ApplySourceControlStatus(NewStatus);
+	}
+}
+
+void FSafeSaveStatusService::HandleSourceControlProviderChanged(ISourceControlProvider& OldProvider, ISourceControlProvider& NewProvider)
+{
+	OldProvider.UnregisterSourceControlStateChanged_Handle(SourceControlStateChangedHandle);
+	SourceControlStateChangedHandle = NewProvider.RegisterSourceControlStateChanged_Handle(FSourceControlStateChanged::FDelegate::CreateRaw(this, &FSafeSaveStatusService::HandleSourceControlStateChanged));
+
+	InvalidateDetectionCache();
+	RequestSourceControlStatusUpdate();
+}
+
+void FSafeSaveStatusService::HandleSourceControlStateChanged()
+{
+	bEditorStatesChanged = true;
+}
+
+FSafeSaveSourceControlStatus FSafeSaveStatusService::QueryProjectStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider PreferredProvider)
+{
+	// Never initialized and already marked shut down: it registers nothing, so its destructor unregisters
+	// nothing, and its detection and index caches belong to this one query.
+	FSafeSaveStatusService QueryService;
+	QueryService.bIsShutDown = true;
+
+	FString FullProjectDir = FPaths::ConvertRelativePathToFull(ProjectDir);
+	FPaths::NormalizeDirectoryName(FullProjectDir);
+	FSafeSaveSourceControlStatus Status = QueryService.QuerySourceControlStatus(FullProjectDir / TEXT(""), PreferredProvider);
+	Status.LastUpdateUtc = FDateTime::UtcNow();
+	return Status;
+}
+
+FSafeSaveSourceControlStatus FSafeSaveStatusService::QuerySourceControlStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider PreferredProvider) const
+{
+	FSafeSaveSourceControlStatus NewStatus;
+	FString GitError;
+	FString PlasticError;
+	bool bGitClientAvailable = false;
+	bool bPlasticClientAvailable = false;
+
+	// With the main root already known, nested repositories are queried while the main query runs.
+	FNestedStatusBatch NestedBatch;
+	const FString KnownRoot = DetectionCache->GetRepoRoot(ProjectDir);
+	if (!KnownRoot.IsEmpty())
+	{
+		LaunchNestedStatus(KnownRoot, ProjectDir, NestedBatch);
+	}
+
+	if (PreferredProvider == ESafeSaveSourceControlProvider::None)
+	{
+		PreferredProvider = DetectionCache->GetProvider(ProjectDir);
+	}
+	FSafeSaveSourceControlStatus GitStatus;
+	FSafeSaveSourceControlStatus PlasticStatus;
+	bool bGitRepoFound = false;
+	bool bPlasticRepoFound = false;
+
+	if (PreferredProvider == ESafeSaveSourceControlProvider::Plastic)
+	{
+		bPlasticRepoFound = PlasticQuery->Query(ProjectDir, PlasticStatus, PlasticError);
+		NewStatus = PlasticStatus;
+	}
+	else if (PreferredProvider == ESafeSaveSourceControlProvider::Git)
+	{
+		bGitRepoFound = GitQuery->Query(ProjectDir, GitStatus, GitError);
+		NewStatus = GitStatus;
+	}
+	else
+	{
+		bGitRepoFound = GitQuery->Query(ProjectDir, GitStatus, GitError);
+		bGitClientAvailable = GitStatus.bClientAvailable;
+
+		if (!bGitRepoFound)
+		{
+			bPlasticRepoFound = PlasticQuery->Query(ProjectDir, PlasticStatus, PlasticError);
+			bPlasticClientAvailable = PlasticStatus.bClientAvailable;
+		}
+
+		if (bGitRepoFound)
+		{
+			NewStatus = GitStatus;
+		}
+		else if (bPlasticRepoFound)
+		{
+			NewStatus = PlasticStatus;
+		}
+		else
+		{
+			NewStatus = FSafeSaveSourceControlStatus();
+			NewStatus.Provider = ESafeSaveSourceControlProvider::None;
+			NewStatus.bClientAvailable = bGitClientAvailable || bPlasticClientAvailable;
+			NewStatus.bRepo = false;
+
+			TArray<FString> Errors;
+			if (!GitError.IsEmpty())
+			{
+				Errors.Add(FString::Printf(TEXT("Git: %s"), *GitError));
+			}
+			if (!PlasticError.IsEmpty())
+			{
+				Errors.Add(FString::Printf(TEXT("Plastic SCM: %s"), *PlasticError));
+			}
+			NewStatus.LastError = Errors.Num() > 0 ? FString::Join(Errors, TEXT("\n")) : FString();
+		}
+	}
+
+	if (NewStatus.bRepo && NewStatus.LastError.IsEmpty())
+	{
+		if (NestedBatch.RepoRoot != NewStatus.RepoRoot)
+		{
+			NestedBatch.Reset();
+			LaunchNestedStatus(NewStatus.RepoRoot, ProjectDir, NestedBatch);
+		}
+		FinishNestedStatus(NestedBatch, NewStatus);
+	}
+
+	return NewStatus;
+}
+
+uint32 FSafeSaveStatusService::GetSharedStatusSettingsHash() const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings)
+	{
+		return 0;
+	}
+
+	uint32 Hash = GetTypeHash((uint8)Settings->GitStatusScanMode);
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings->bLazyAheadBehind));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings->bIncludeSubmodules));
+	Hash = HashCombineFast(Hash, GetTypeHash(Settings->bScopeStatusToPaths));
+	for (const FString& Path : Settings->StatusScopePaths)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(Path));
+	}
+	for (const FString& Root : Settings->NestedRepositoryRoots)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(Root));
+	}
+	return Hash;
+}
+
+bool FSafeSaveStatusService::QueryProviderStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider Provider, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const
+{
+	switch (Provider)
+	{
+	case ESafeSaveSourceControlProvider::Git:
+		return GitQuery->Query(ProjectDir, OutStatus, OutError);
+	case ESafeSaveSourceControlProvider::Plastic:
+		return PlasticQuery->Query(ProjectDir, OutStatus, OutError);
+	default:
+		OutStatus = FSafeSaveSourceControlStatus();
+		return false;
+	}
+}
+
+ESafeSaveFileStatus FSafeSaveStatusService::GetPackageStatus(FName PackageName) const
+{
+	const FSafeSaveFileStatusIndexPtr& Index = GetStatusSnapshot().FileIndex;
+	return Index.IsValid() ? Index->Find(PackageName) : ESafeSaveFileStatus::None;
+}
+
+const FSafeSaveFileLock* FSafeSaveStatusService::FindPackageLock(FName PackageName) const
+{
+	return LockTracker->Find(PackageName);
+}
+
+ESafeSaveSourceControlProvider FSafeSaveStatusService::GetPreferredProvider() const
+{
+	if (ISourceControlModule::Get().IsEnabled())
+	{
+		return FSafeSaveEditorSourceControl::ToCommandLineProvider(ISourceControlModule::Get().GetProvider().GetName().ToString());
+	}
+
+	return ESafeSaveSourceControlProvider::None;
+}
+
+void FSafeSaveStatusService::InvalidateDetectionCache() const
+{
+	DetectionCache->Invalidate();
+}
+
+TArray<FSafeSaveStatusService::FNestedRepository> FSafeSaveStatusService::GetNestedRepositories(const FString& RepoRoot, const FString& ProjectDir) const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Settings || (!Settings->bIncludeSubmodules && Settings->NestedRepositoryRoots.Num() == 0))
+	{
+		return TArray<FNestedRepository>();
+	}
+
+	// Relative nested roots resolve against the project, so the same repository can find different ones.
+	uint32 SettingsHash = HashCombineFast(GetTypeHash(Settings->bIncludeSubmodules), GetTypeHash(ProjectDir));
+	for (const FString& Root : Settings->NestedRepositoryRoots)
+	{
+		SettingsHash = HashCombineFast(SettingsHash, GetTypeHash(Root));
+	}
+
+	{
+		FScopeLock Lock(&NestedCacheLock);
+		if (NestedRepositoryCache.bDiscovered && NestedRepositoryCache.RepoRoot == RepoRoot && NestedRepositoryCache.SettingsHash == SettingsHash)
+		{
+			return NestedRepositoryCache.Repositories;
+		}
+	}
+
+	TArray<FNestedRepository> Repositories;
+	const auto AddRepository = [&Repositories, &RepoRoot](FString Root, ESafeSaveSourceControlProvider Provider)
+	{
+		FPaths::NormalizeDirectoryName(Root);
+		FPaths::CollapseRelativeDirectories(Root);
+		if (Root.Equals(RepoRoot, ESearchCase::IgnoreCase) || Repositories.ContainsByPredicate([&Root](const FNestedRepository& Existing) { return Existing.Root.Equals(Root, ESearchCase::IgnoreCase); }))
+		{
+			return;
+		}
+		Repositories.Add({ MoveTemp(Root), Provider });
+	};
+	const auto HasGitMetadata = [](const FString& Root)
+	{
+		// A directory for regular repositories, a "gitdir:" file for submodules and worktrees.
+		return FPaths::DirectoryExists(Root / TEXT(".git")) || FPaths::FileExists(Root / TEXT(".git"));
+	};
+
+	FString GitModules;
+	if (Settings->bIncludeSubmodules && FFileHelper::LoadFileToString(GitModules, *(RepoRoot / TEXT(".gitmodules"))))
+	{
+		TArray<FString> Lines;
+		GitModules.ParseIntoArrayLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			FString Key;
+			FString Value;
+			if (Line.Split(TEXT("="), &Key, &Value) && TrimCopy(Key) == TEXT("path"))
+			{
+				// Uninitialized submodules are empty directories without git metadata.
+				const FString Root = RepoRoot / TrimCopy(Value);
+				if (HasGitMetadata(Root))
+				{
+					AddRepository(Root, ESafeSaveSourceControlProvider::Git);
+				}
+			}
+		}
+	}
+
+	for (const FString& ConfiguredRoot : Settings->NestedRepositoryRoots)
+	{
+		const FString Trimmed = TrimCopy(ConfiguredRoot);
+		if (Trimmed.IsEmpty())
+		{
+			continue;
+		}
+
+		const FString Root = FPaths::IsRelative(Trimmed) ? FPaths::ConvertRelativePathToFull(ProjectDir, Trimmed) : Trimmed;
+		if (HasGitMetadata(Root))
+		{
+			AddRepository(Root, ESafeSaveSourceControlProvider::Git);
+		}
+		else if (FPaths::DirectoryExists(Root / TEXT(".plastic")))
+		{
+			AddRepository(Root, ESafeSaveSourceControlProvider::Plastic);
+		}
+	}
+
+	FScopeLock Lock(&NestedCacheLock);
+	NestedRepositoryCache.bDiscovered = true;
+	NestedRepositoryCache.RepoRoot = RepoRoot;
+	NestedRepositoryCache.SettingsHash = SettingsHash;
+	NestedRepositoryCache.Repositories = Repositories;
+	return Repositories;
+}
+
+void FSafeSaveStatusService::LaunchNestedStatus(const FString& RepoRoot, const FString& ProjectDir, FNestedStatusBatch& Batch) const
+{
+	Batch.RepoRoot = RepoRoot;
+
+	const TArray<FNestedRepository> Repositories = GetNestedRepositories(RepoRoot, ProjectDir);
+	if (Repositories.Num() == 0)
+	{
+		return;
+	}
+
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const bool bTrackedOnly = Settings && Settings->GitStatusScanMode == ESafeSaveGitStatusScanMode::TrackedOnly;
+	const FString GitArgs = bTrackedOnly ? TEXT("--no-optional-locks status --porcelain=v2 -z --untracked-files=no") : TEXT("--no-optional-locks status --porcelain=v2 -z");
+
+	Batch.Group = MakeUnique<FSafeSaveProcessGroup>();
+	for (const FNestedRepository& Repository : Repositories)
+	{
+		FNestedStatusBatch::FResult& Result = *Batch.Results.Add_GetRef(MakeUnique<FNestedStatusBatch::FResult>(Repository));
+		if (Repository.Provider == ESafeSaveSourceControlProvider::Git)
+		{
+			Result.Parser = MakeUnique<FSafeSaveGitStatusParser>(Result.Status);
+			Result.Parser->SetFileIndexBuilder(&Result.Builder);
+			FSafeSaveGitStatusParser* Parser = Result.Parser.Get();
+			Result.ProcessIndex = Batch.Group->Launch(FSafeSaveCommandRunner::GetGitExecutable(), GitArgs, Repository.Root, [Parser](const uint8* Data, int32 Num)
+			{
+				Parser->Feed(Data, Num);
+			});
+		}
+		else
+		{
+			TArray<uint8>* Output = &Result.PlasticOutput;
+			Result.ProcessIndex = Batch.Group->Launch(FSafeSaveCommandRunner::GetPlasticExecutable(), FSafeSavePlasticStatusQuery::MakeStatusArgs(FString()), Repository.Root, [Output](const uint8* Data, int32 Num)
+			{
+				Output->Append(Data, Num);
+			});
+		}
+	}
+}
+
+void FSafeSaveStatusService::FinishNestedStatus(FNestedStatusBatch& Batch, FSafeSaveSourceControlStatus& InOutStatus) const
+{
+	if (!Batch.Group.IsValid() || Batch.Results.Num() == 0)
+	{
+		return;
+	}
+
+	Batch.Group->WaitAll(CommandRunner->GetProcessLimits(false));
+
+	FSafeSaveFileStatusIndex::FBuilder NestedBuilder(InOutStatus.RepoRoot);
+	for (const TUniquePtr<FNestedStatusBatch::FResult>& ResultPtr : Batch.Results)
+	{
+		FNestedStatusBatch::FResult& Result = *ResultPtr;
+		++InOutStatus.NestedRepositories;
+
+		if (!Batch.Group->WasLaunched(Result.ProcessIndex) || Batch.Group->GetExitCode(Result.ProcessIndex) != 0)
+		{
+			++InOutStatus.NestedRepositoriesFailed;
+			continue;
+		}
+
+		if (Result.Parser.IsValid())
+		{
+			Result.Parser->Finish();
+		}
+		else
+		{
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Result.PlasticOutput.GetData()), Result.PlasticOutput.Num());
+			FSafeSavePlasticStatusQuery::ParseStatusOutput(FString(Converted.Length(), Converted.Get()), Result.Status, &Result.Builder);
+		}
+
+		InOutStatus.Staged += Result.Status.Staged;
+		InOutStatus.Unstaged += Result.Status.Unstaged;
+		InOutStatus.Untracked += Result.Status.Untracked;
+		InOutStatus.bHasConflicts |= Result.Status.bHasConflicts;
+		NestedBuilder.Append(Result.Builder);
+	}
+
+	if (NestedBuilder.NumEntries() == 0)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&NestedCacheLock);
+	if (!NestedIndexCache.Combined.IsValid() || NestedIndexCache.MainIndex != InOutStatus.FileIndex || NestedIndexCache.NestedChecksum != NestedBuilder.GetChecksum())
+	{
+		const TSharedRef<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> NestedIndex = NestedBuilder.Build();
+		NestedIndexCache.MainIndex = InOutStatus.FileIndex;
+		NestedIndexCache.NestedChecksum = NestedBuilder.GetChecksum();
+		NestedIndexCache.Combined = InOutStatus.FileIndex.IsValid()
+			? FSafeSaveFileStatusIndexPtr(FSafeSaveFileStatusIndex::Combine(*InOutStatus.FileIndex, *NestedIndex))
+			: FSafeSaveFileStatusIndexPtr(NestedIndex);
+	}
+	InOutStatus.FileIndex = NestedIndexCache.Combined;
+}
+
+bool FSafeSaveStatusService::CanExecuteGitCommand() const
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	return IsGitProvider() && Status.bClientAvailable && Status.bRepo;
+}
+
+bool FSafeSaveStatusService::CanExecuteGitPull() const
+{
+	return FSafeSaveStatusChecks::CanPull(GetStatusSnapshot(), bHasUnsavedAssets);
+}
+
+bool FSafeSaveStatusService::CanExecuteGitPush() const
+{
+	return FSafeSaveStatusChecks::CanPush(GetStatusSnapshot(), bHasUnsavedAssets);
+}
+
+bool FSafeSaveStatusService::CanExecutePlasticUpdate() const
+{
+	return FSafeSaveStatusChecks::CanUpdatePlastic(GetStatusSnapshot(), bHasUnsavedAssets);
+}
+
+TArray<FString> FSafeSaveStatusService::GetFailedSafetyChecks() const
+{
+	return FSafeSaveStatusChecks::Evaluate(GetStatusSnapshot(), UnsavedAssetCount, FSafeSaveStatusChecks::FOptions());
+}
+
+bool FSafeSaveStatusService::IsGitProvider() const
+{
+	return GetStatusSnapshot().Provider == ESafeSaveSourceControlProvider::Git;
+}
+
+bool FSafeSaveStatusService::IsPlasticProvider() const
+{
+	return GetStatusSnapshot().Provider == ESafeSaveSourceControlProvider::Plastic;
+}
+
+const FSlateBrush* FSafeSaveStatusService::BuildStatusIcon() const
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+
+	if (Status.bAuthRequired)
+	{
+		return FAppStyle::GetBrush("Icons.WarningWithColor");
+	}
+
+	if (!Status.bClientAvailable || !Status.bRepo)
+	{
+		return FAppStyle::GetBrush("Icons.Warning");
+	}
+
+	if (Status.bHasConflicts || (Status.Ahead > 0 && Status.Behind > 0))
+	{
+		return FAppStyle::GetBrush("Icons.WarningWithColor");
+	}
+
+	if (bHasUnsavedAssets)
+	{
+		return FAppStyle::GetBrush("Icons.Save");
+	}
+
+	if (Status.Behind > 0)
+	{
+		return FAppStyle::GetBrush("Icons.Refresh");
+	}
+
+	if (Status.Ahead > 0)
+	{
+		return FAppStyle::GetBrush("Icons.Save");
+	}
+
+	if (Status.Staged + Status.Unstaged + Status.Untracked > 0)
+	{
+		return FAppStyle::GetBrush("Icons.Save");
+	}
+
+	return FAppStyle::GetBrush("Icons.Info");
+}
+
+FText FSafeSaveStatusService::BuildStatusLabel() const
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+
+	if (!Status.bClientAvailable)
+	{
+		return LOCTEXT("SCMMissing", "SCM Missing");
+	}
+
+	if (Status.bAuthRequired)
+	{
+		return LOCTEXT("SCMLoginRequired", "Login Required");
+	}
+
+	if (!Status.bRepo)
+	{
+		return LOCTEXT("NoRepo", "No SCM Repo");
+	}
+
+	FString Branch = Status.Branch;
+	if (Branch.IsEmpty())
+	{
+		Branch = Status.WorkspaceName;
+	}
+	if (Branch.IsEmpty() && Status.bAuthRequired && IsPlasticProvider())
+	{
+		Branch = TEXT("Plastic");
+	}
+	if (Branch.IsEmpty())
+	{
+		Branch = TEXT("unknown");
+	}
+	if (IsGitProvider() && Branch.Contains(TEXT("detached")))
+	{
+		Branch = TEXT("detached");
+	}
+
+	FString StateText;
+	if (Status.bHasConflicts)
+	{
+		StateText = TEXT("Conflicts");
+	}
+	else if (bHasUnsavedAssets)
+	{
+		StateText = FString::Printf(TEXT("Unsaved %d"), UnsavedAssetCount);
+	}
+	else if (Status.Ahead > 0 && Status.Behind > 0)
+	{
+		StateText = TEXT("Diverged");
+	}
+	else if (Status.Behind > 0)
+	{
+		StateText = FString::Printf(TEXT("Behind %d"), Status.Behind);
+	}
+	else if (Status.Staged + Status.Unstaged + Status.Untracked > 0)
+	{
+		StateText = TEXT("Changes");
+	}
+	else if (Status.Ahead > 0)
+	{
+		StateText = FString::Printf(TEXT("Ahead %d"), Status.Ahead);
+	}
+	else
+	{
+		StateText = TEXT("Clean");
+	}
+
+	return FText::FromString(FString::Printf(TEXT("%s | %s"), *Branch, *StateText));
+}
+
+FSlateColor FSafeSaveStatusService::BuildStatusColor() const
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+
+	if (Status.bAuthRequired)
+	{
+		return FLinearColor(1.0f, 0.65f, 0.0f);
+	}
+
+	if (!Status.bClientAvailable || !Status.bRepo)
+	{
+		return FLinearColor::Gray;
+	}
+
+	if (Status.bHasConflicts || (Status.Ahead > 0 && Status.Behind > 0))
+	{
+		return FLinearColor(1.0f, 0.2f, 0.2f);
+	}
+
+	if (bHasUnsavedAssets)
+	{
+		return FLinearColor(1.0f, 0.5f, 0.0f);
+	}
+
+	if (Status.Behind > 0)
+	{
+		return FLinearColor(0.0f, 0.45f, 1.0f);
+	}
+
+	if (Status.Staged + Status.Unstaged + Status.Untracked > 0)
+	{
+		return FLinearColor(1.0f, 0.5f, 0.0f);
+	}
+
+	return FLinearColor(0.2f, 0.85f, 0.2f);
+}
+
+FText FSafeSaveStatusService::BuildStatusTooltip() const
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	FString Tooltip;
+
+	if (!Status.bClientAvailable)
+	{
+		Tooltip = TEXT("Git or Plastic SCM CLI not found. Install Git or Unity Version Control (Plastic SCM) CLI and restart the editor.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Tooltip += TEXT("\n");
+			Tooltip += Status.LastError;
+		}
+		return FText::FromString(Tooltip);
+	}
+
+	if (Status.bAuthRequired)
+	{
+		Tooltip = TEXT("Plastic SCM login required. Sign in via Source Control to continue.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Tooltip += TEXT("\n");
+			Tooltip += Status.LastError;
+		}
+		return FText::FromString(Tooltip);
+	}
+
+	if (!Status.bRepo)
+	{
+		Tooltip = TEXT("Project is not inside a Git repository or Plastic SCM workspace.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Tooltip += TEXT("\n");
+			Tooltip += Status.LastError;
+		}
+		return FText::FromString(Tooltip);
+	}
+
+	Tooltip += FString::Printf(TEXT("Provider: %s\n"), *BuildProviderLabel().ToString());
+	if (IsPlasticProvider() && !Status.WorkspaceName.IsEmpty())
+	{
+		Tooltip += FString::Printf(TEXT("Workspace: %s\n"), *Status.WorkspaceName);
+	}
+	Tooltip += FString::Printf(TEXT("Root: %s\n"), *Status.RepoRoot);
+
+	FString BranchLabel = Status.Branch;
+	if (BranchLabel.IsEmpty())
+	{
+		BranchLabel = Status.WorkspaceName;
+	}
+	if (!BranchLabel.IsEmpty())
+	{
+		Tooltip += FString::Printf(TEXT("Branch: %s\n"), *BranchLabel);
+	}
+
+	if (IsGitProvider())
+	{
+		if (Status.bHasUpstream)
+		{
+			Tooltip += FString::Printf(TEXT("Ahead: %d  Behind: %d\n"), Status.Ahead, Status.Behind);
+		}
+		else
+		{
+			Tooltip += TEXT("Upstream: not set\n");
+		}
+
+		Tooltip += FString::Printf(TEXT("Staged: %d  Unstaged: %d  Untracked: %d\n"), Status.Staged, Status.Unstaged, Status.Untracked);
+		if (!Status.ScanMode.IsEmpty())
+		{
+			Tooltip += FString::Printf(TEXT("Status scan: %s\n"), *Status.ScanMode);
+		}
+		if (Status.NestedRepositories > 0)
+		{
+			Tooltip += Status.NestedRepositoriesFailed > 0
+				? FString::Printf(TEXT("Nested repositories: %d (%d failed)\n"), Status.NestedRepositories, Status.NestedRepositoriesFailed)
+				: FString::Printf(TEXT("Nested repositories: %d\n"), Status.NestedRepositories);
+		}
+	}
+	else if (IsPlasticProvider())
+	{
+		if (Status.Behind > 0)
+		{
+			Tooltip += FString::Printf(TEXT("Updates available: %d\n"), Status.Behind);
+		}
+		Tooltip += FString::Printf(TEXT("Pending changes: %d\n"), Status.Unstaged + Status.Untracked);
+	}
+	else if (!Status.EditorProviderName.IsEmpty())
+	{
+		if (Status.Behind > 0)
+		{
+			Tooltip += FString::Printf(TEXT("Out of date files: %d\n"), Status.Behind);
+		}
+		Tooltip += FString::Printf(TEXT("Pending changes: %d\n"), Status.Unstaged + Status.Untracked);
+	}
+
+	if (bHasUnsavedAssets)
+	{
+		Tooltip += FString::Printf(TEXT("Unsaved assets: %d\n"), UnsavedAssetCount);
+		if (!SampleUnsavedPackage.IsEmpty())
+		{
+			Tooltip += FString::Printf(TEXT("Example: %s\n"), *SampleUnsavedPackage);
+		}
+	}
+
+	if (Status.LastUpdateUtc != FDateTime())
+	{
+		// An absolute time keeps the tooltip stable between refreshes, so it is only rebuilt when status changes.
+		Tooltip += Status.bStale
+			? FString::Printf(TEXT("From the last session (%s); refreshing once the editor has started"), *FText::AsDateTime(Status.LastUpdateUtc).ToString())
+			: FString::Printf(TEXT("Updated: %s"), *FText::AsTime(Status.LastUpdateUtc).ToString());
+	}
+
+	return FText::FromString(Tooltip);
+}
+
+FText FSafeSaveStatusService::BuildProviderLabel() const
+{
+	switch (GetStatusSnapshot().Provider)
+	{
+	case ESafeSaveSourceControlProvider::Git:
+		return LOCTEXT("ProviderGit", "Git");
+	case ESafeSaveSourceControlProvider::Plastic:
+		return LOCTEXT("ProviderPlastic", "Plastic SCM");
+	default:
+		return GetStatusSnapshot().EditorProviderName.IsEmpty()
+			? LOCTEXT("ProviderSourceControl", "Source Control")
+			: FText::FromString(GetStatusSnapshot().EditorProviderName);
+	}
+}
+
+void FSafeSaveStatusService::RefreshPresentation()
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_RefreshPresentation, FSafeSaveStatusService::RefreshPresentation);
+
+	const FText Label = BuildStatusLabel();
+	const FText Tooltip = BuildStatusTooltip();
+	FString LabelString = Label.ToString();
+	FString TooltipString = Tooltip.ToString();
+	const FSlateBrush* Icon = BuildStatusIcon();
+	// A restored status is drawn faded until a live query confirms it.
+	const FSlateColor Color = GetStatusSnapshot().bStale
+		? FSlateColor(BuildStatusColor().GetSpecifiedColor().CopyWithNewOpacity(0.5f))
+		: BuildStatusColor();
+
+	const bool bChanged = PresentationVersion == 0
+		|| Icon != Presentation.Icon
+		|| Color != Presentation.Color
+		|| LabelString != Presentation.LabelString
+		|| TooltipString != Presentation.TooltipString;
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	Presentation.Icon = Icon;
+	Presentation.Color = Color;
+	Presentation.Label = Label;
+	Presentation.Tooltip = Tooltip;
+	Presentation.ProviderLabel = BuildProviderLabel();
+	Presentation.LabelString = MoveTemp(LabelString);
+	Presentation.TooltipString = MoveTemp(TooltipString);
+	++PresentationVersion;
+
+	MaybeNotifyStatusChange();
+}
+
+void FSafeSaveStatusService::MaybeNotifyStatusChange()
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const FString& CurrentLabel = Presentation.LabelString;
+
+	if (!Settings || !Settings->bToastOnStatusChange)
+	{
+		LastStatusLabel = CurrentLabel;
+		bHasSeenStatusLabel = true;
+		return;
+	}
+
+	if (GetStatusSnapshot().bStale)
+	{
+		// The restored label is not news; the first live label is compared with what came before it.
+		return;
+	}
+
+	if (!bHasSeenStatusLabel)
+	{
+		LastStatusLabel = CurrentLabel;
+		bHasSeenStatusLabel = true;
+		return;
+	}
+
+	if (CurrentLabel != LastStatusLabel)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		const double MinInterval = FMath::Max(0.5, (double)Settings->StatusToastMinIntervalSeconds);
+
+		if (NowSeconds - LastStatusToastSeconds >= MinInterval)
+		{
+			Notify(FText::FromString(FString::Printf(TEXT("SafeSave: %s"), *CurrentLabel)), true);
+			LastStatusToastSeconds = NowSeconds;
+		}
+
+		LastStatusLabel = CurrentLabel;
+	}
+}
+
+void FSafeSaveStatusService::UpdateRepositoryWatcher()
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	const bool bShouldWatch = Settings && Settings->bWatchRepositoryForChanges
+		&& Status.Provider == ESafeSaveSourceControlProvider::Git
+		&& Status.bRepo
+		&& !Status.RepoRoot.IsEmpty();
+
+	if (bShouldWatch)
+	{
+		RepositoryWatcher->Watch(Status.RepoRoot);
+	}
+	else
+	{
+		RepositoryWatcher->Stop();
+	}
+}
+
+void FSafeSaveStatusService::HandleRepositoryChanged(bool bIndexOnly)
+{
+	// In accelerated scan mode our own status persists the untracked cache/fsmonitor token into the index;
+	// don't let that write schedule another refresh. Only an index left exactly as our status wrote it is
+	// ignored, so an external `git add` or `git reset` in the same moment still refreshes.
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	const bool bMaySelfWriteIndex = Settings && Settings->GitStatusScanMode == ESafeSaveGitStatusScanMode::Accelerated;
+	if (bIndexOnly && bMaySelfWriteIndex)
+	{
+		if (bStatusUpdateInFlight.Load())
+		{
+			bIndexChangedDuringStatus = true;
+			return;
+		}
+		if (RepositoryWatcher.IsValid() && GitQuery->IsSelfWrittenIndex(RepositoryWatcher->GetWatchedRoot()))
+		{
+			return;
+		}
+	}
+
+	// HEAD, config, refs or worktree metadata moved (checkout, submodule changes); re-detect the repository on the
+	// next refresh. Staging or resetting only rewrites the index, which changes the status but not the repository.
+	if (!bIndexOnly)
+	{
+		InvalidateDetectionCache();
+	}
+	PollScheduler->ResetBackoff();
+	bRepositoryChangePending = true;
+	LastRepositoryChangeSeconds = FPlatformTime::Seconds();
+	LastStatusInvalidationUtc = FDateTime::UtcNow();
+}
+
+void FSafeSaveStatusService::HandleSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const TSharedRef<const FSafeSavePackageFilter> NewFilter = FSafeSavePackageFilter::Create(GetDefault<USafeSaveSettings>());
+	if (PackageFilter.IsValid() && PackageFilter->HasSameRules(*NewFilter))
+	{
+		return;
+	}
+
+	PackageFilter = NewFilter;
+	if (DirtyPackageTracker.IsValid())
+	{
+		DirtyPackageTracker->SetFilter(NewFilter);
+	}
+	UpdateUnsavedState();
+}
+
+void FSafeSaveStatusService::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (!ObjectSaveContext.IsProceduralSave() && !bSaveAllInProgress)
+	{
+		bRepositoryChangePending = true;
+		LastRepositoryChangeSeconds = FPlatformTime::Seconds();
+		LastStatusInvalidationUtc = FDateTime::UtcNow();
+	}
+}
+
+void FSafeSaveStatusService::HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	if (!bWasDirty)
+	{
+		WarnIfLockedByOthers(Package);
+	}
+}
+
+void FSafeSaveStatusService::HandleAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	if (Asset)
+	{
+		WarnIfLockedByOthers(Asset->GetPackage());
+	}
+}
+
+void FSafeSaveStatusService::WarnIfLockedByOthers(const UPackage* Package)
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	if (!Package || !Settings || !Settings->bQueryLocks || !Settings->bWarnOnLockedAssets)
+	{
+		return;
+	}
+
+	FString LockOwner;
+	if (!LockTracker->TakeUnwarnedOwner(Package->GetFName(), LockOwner))
+	{
+		return;
+	}
+
+	const FText Owner = LockOwner.IsEmpty() ? LOCTEXT("UnknownLockOwner", "another user") : FText::FromString(LockOwner);
+	Notify(FText::Format(LOCTEXT("LockedByOther", "LOCKED by {0}: {1}"), Owner, FText::FromName(Package->GetFName())), false);
+}
+
+void FSafeSaveStatusService::RequestLockRefresh()
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	uint32 PreviousChecksum = 0;
+	if (!LockTracker->BeginRefresh(Status, PreviousChecksum))
+	{
+		return;
+	}
+
+	const ESafeSaveSourceControlProvider Provider = Status.Provider;
+	const FString RepoRoot = Status.RepoRoot;
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+
+	const bool bQueued = Worker->Enqueue([SelfWeak, Provider, RepoRoot, PreviousChecksum]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		const FSafeSaveLockTracker::FQueryResult Result = Pinned->LockTracker->Query(Provider, RepoRoot, PreviousChecksum);
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, Result]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (PinnedGame.IsValid() && !PinnedGame->bIsShutDown)
+			{
+				PinnedGame->LockTracker->FinishRefresh(Result);
+			}
+		});
+	});
+
+	if (!bQueued)
+	{
+		LockTracker->CancelRefresh();
+	}
+}
+
+FString FSafeSaveStatusService::BuildStatusSummary(const FSafeSaveSourceControlStatus& Status) const
+{
+	FString Summary;
+
+	if (!Status.bClientAvailable)
+	{
+		Summary = TEXT("Git or Plastic SCM CLI not found. Install Git or Unity Version Control (Plastic SCM) CLI and restart the editor.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Summary += TEXT("\n\nDetails:\n");
+			Summary += Status.LastError;
+		}
+		return Summary;
+	}
+
+	if (Status.bAuthRequired)
+	{
+		Summary = TEXT("Plastic SCM login required. Sign in via Source Control to continue.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Summary += TEXT("\n\nDetails:\n");
+			Summary += Status.LastError;
+		}
+		return Summary;
+	}
+
+	if (!Status.bRepo)
+	{
+		Summary = TEXT("Project is not inside a Git repository or Plastic SCM workspace.");
+		if (!Status.LastError.IsEmpty())
+		{
+			Summary += TEXT("\n\nDetails:\n");
+			Summary += Status.LastError;
+		}
+		return Summary;
+	}
+
+	Summary += FString::Printf(TEXT("Provider: %s\n"), *GetProviderLabel().ToString());
+	if (IsPlasticProvider() && !Status.WorkspaceName.IsEmpty())
+	{
+		Summary += FString::Printf(TEXT("Workspace: %s\n"), *Status.WorkspaceName);
+	}
+	Summary += FString::Printf(TEXT("Root: %s\n"), *Status.RepoRoot);
+
+	FString BranchLabel = Status.Branch;
+	if (BranchLabel.IsEmpty())
+	{
+		BranchLabel = Status.WorkspaceName;
+	}
+	if (!BranchLabel.IsEmpty())
+	{
+		Summary += FString::Printf(TEXT("Branch: %s\n"), *BranchLabel);
+	}
+
+	if (IsGitProvider())
+	{
+		if (Status.bHasUpstream)
+		{
+			Summary += FString::Printf(TEXT("Ahead: %d  Behind: %d\n"), Status.Ahead, Status.Behind);
+		}
+		else
+		{
+			Summary += TEXT("Upstream: not set\n");
+		}
+
+		Summary += FString::Printf(TEXT("Staged: %d  Unstaged: %d  Untracked: %d\n"), Status.Staged, Status.Unstaged, Status.Untracked);
+		if (!Status.ScanMode.IsEmpty())
+		{
+			Summary += FString::Printf(TEXT("Status scan: %s\n"), *Status.ScanMode);
+		}
+		if (Status.NestedRepositories > 0)
+		{
+			Summary += Status.NestedRepositoriesFailed > 0
+				? FString::Printf(TEXT("Nested repositories: %d (%d failed)\n"), Status.NestedRepositories, Status.NestedRepositoriesFailed)
+				: FString::Printf(TEXT("Nested repositories: %d\n"), Status.NestedRepositories);
+		}
+	}
+	else if (IsPlasticProvider())
+	{
+		if (Status.Behind > 0)
+		{
+			Summary += FString::Printf(TEXT("Updates available: %d\n"), Status.Behind);
+		}
+		Summary += FString::Printf(TEXT("Pending changes: %d\n"), Status.Unstaged + Status.Untracked);
+	}
+	else if (!Status.EditorProviderName.IsEmpty())
+	{
+		if (Status.Behind > 0)
+		{
+			Summary += FString::Printf(TEXT("Out of date files: %d\n"), Status.Behind);
+		}
+		Summary += FString::Printf(TEXT("Pending changes: %d\n"), Status.Unstaged + Status.Untracked);
+	}
+
+	if (bHasUnsavedAssets)
+	{
+		Summary += FString::Printf(TEXT("Unsaved assets: %d\n"), UnsavedAssetCount);
+		if (!SampleUnsavedPackage.IsEmpty())
+		{
+			Summary += FString::Printf(TEXT("Example: %s\n"), *SampleUnsavedPackage);
+		}
+	}
+
+	return Summary;
+}
+
+void FSafeSaveStatusService::RunGitCommandAsync(const FString& Args, const FText& SuccessMessage, const FText& FailureMessage, bool bRefreshAfter, bool bSilentSuccess, bool bReloadChangedPackages)
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	if (!IsGitProvider() || !Status.bClientAvailable || !Status.bRepo)
+	{
+		Notify(LOCTEXT("GitUnavailable", "Git is not available for this project."), false);
+		return;
+	}
+
+	const FString WorkingDir = Status.RepoRoot.IsEmpty() ? FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()) : Status.RepoRoot;
+	const bool bCaptureChanges = ShouldReloadChangedPackages(bReloadChangedPackages);
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+
+	Worker->Enqueue([SelfWeak, WorkingDir, Args, SuccessMessage, FailureMessage, bRefreshAfter, bSilentSuccess, bCaptureChanges]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		// The commit before the command; ORIG_HEAD is not reliable across rebase, merge and fast-forward pulls.
+		FSafeSaveGitRepository::FHeadInfo HeadBefore;
+		const bool bHasHeadBefore = bCaptureChanges && FSafeSaveGitRepository::ReadHead(WorkingDir, HeadBefore) && !HeadBefore.HeadOid.IsEmpty();
+
+		FString StdOut;
+		FString StdErr;
+		int32 ExitCode = 0;
+		const bool bLaunched = Pinned->CommandRunner->RunGit(Args, WorkingDir, StdOut, StdErr, ExitCode, true);
+		const bool bSuccess = bLaunched && ExitCode == 0;
+		const FString ErrorText = TrimCopy(StdErr);
+
+		TArray<FString> ChangedFiles;
+		FSafeSaveGitRepository::FHeadInfo HeadAfter;
+		if (bSuccess && bHasHeadBefore && FSafeSaveGitRepository::ReadHead(WorkingDir, HeadAfter) && !HeadAfter.HeadOid.IsEmpty() && HeadAfter.HeadOid != HeadBefore.HeadOid)
+		{
+			FString DiffOut;
+			FString DiffErr;
+			int32 DiffExitCode = 0;
+			const FString DiffArgs = FString::Printf(TEXT("-c core.quotepath=off diff --name-only --no-renames %s %s"), *HeadBefore.HeadOid, *HeadAfter.HeadOid);
+			if (Pinned->CommandRunner->RunGit(DiffArgs, WorkingDir, DiffOut, DiffErr, DiffExitCode) && DiffExitCode == 0)
+			{
+				FSafeSavePackageReloader::ParseGitDiffNames(DiffOut, WorkingDir, ChangedFiles);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, bSuccess, SuccessMessage, FailureMessage, bRefreshAfter, ErrorText, bSilentSuccess, ChangedFiles]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (!PinnedGame.IsValid() || PinnedGame->bIsShutDown)
+			{
+				return;
+			}
+
+			if (!(bSuccess && bSilentSuccess))
+			{
+				PinnedGame->Notify(bSuccess ? SuccessMessage : FailureMessage, bSuccess);
+			}
+			if (!bSuccess && !ErrorText.IsEmpty())
+			{
+				PinnedGame->Notify(FText::FromString(ErrorText.Left(200)), false);
+			}
+
+			if (ChangedFiles.Num() > 0)
+			{
+				PinnedGame->ReloadChangedPackages(ChangedFiles);
+			}
+
+			if (bRefreshAfter)
+			{
+				PinnedGame->RequestSourceControlStatusUpdate();
+				if (bSuccess)
+				{
+					PinnedGame->RequestLockRefresh();
+				}
+			}
+		});
+	});
+}
+
+void FSafeSaveStatusService::RunAutoFetchAsync(bool bFullFetch)
+{
+	if (bFullFetch)
+	{
+		RunGitCommandAsync(TEXT("fetch --prune"), LOCTEXT("AutoFetchSuccess", "Auto fetch completed."), LOCTEXT("AutoFetchFail", "Auto fetch failed."), true, true);
+		return;
+	}
+
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	if (!IsGitProvider() || !Status.bClientAvailable || !Status.bRepo || !Status.bHasUpstream)
+	{
+		return;
+	}
+
+	const FString RepoRoot = Status.RepoRoot;
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+
+	Worker->Enqueue([SelfWeak, RepoRoot]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		const FSafeSaveAutoFetch::FResult Result = Pinned->AutoFetch->FetchUpstreamIfMoved(RepoRoot);
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, Result]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (!PinnedGame.IsValid() || PinnedGame->bIsShutDown)
+			{
+				return;
+			}
+
+			if (!Result.bSuccess)
+			{
+				PinnedGame->Notify(LOCTEXT("AutoFetchFail", "Auto fetch failed."), false);
+				if (!Result.ErrorText.IsEmpty())
+				{
+					PinnedGame->Notify(FText::FromString(Result.ErrorText.Left(200)), false);
+				}
+			}
+			else if (Result.bFetched)
+			{
+				PinnedGame->RequestSourceControlStatusUpdate();
+				PinnedGame->RequestLockRefresh();
+			}
+		});
+	});
+}
+
+void FSafeSaveStatusService::RunPlasticCommandAsync(const FString& Args, const FText& SuccessMessage, const FText& FailureMessage, bool bRefreshAfter, bool bSilentSuccess, bool bReloadChangedPackages)
+{
+	const FSafeSaveSourceControlStatus& Status = GetStatusSnapshot();
+	if (!IsPlasticProvider() || !Status.bClientAvailable || !Status.bRepo)
+	{
+		Notify(LOCTEXT("PlasticUnavailable", "Plastic SCM is not available for this project."), false);
+		return;
+	}
+
+	const FString WorkingDir = Status.RepoRoot.IsEmpty() ? FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()) : Status.RepoRoot;
+	const bool bCaptureChanges = ShouldReloadChangedPackages(bReloadChangedPackages);
+	TWeakPtr<FSafeSaveStatusService> SelfWeak = AsShared();
+
+	Worker->Enqueue([SelfWeak, WorkingDir, Args, SuccessMessage, FailureMessage, bRefreshAfter, bSilentSuccess, bCaptureChanges]()
+	{
+		TSharedPtr<FSafeSaveStatusService> Pinned = SelfWeak.Pin();
+		if (!Pinned.IsValid())
+		{
+			return;
+		}
+
+		FString StdOut;
+		FString StdErr;
+		int32 ExitCode = 0;
+		const bool bLaunched = Pinned->CommandRunner->RunPlastic(Args, WorkingDir, StdOut, StdErr, ExitCode, true);
+		const bool bSuccess = bLaunched && ExitCode == 0;
+		const FString ErrorText = TrimCopy(StdErr);
+
+		// The update already lists every item it touched, so no second query is needed.
+		TArray<FString> ChangedFiles;
+		if (bSuccess && bCaptureChanges)
+		{
+			FSafeSavePackageReloader::ParsePlasticUpdateOutput(StdOut, WorkingDir, ChangedFiles);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [SelfWeak, bSuccess, SuccessMessage, FailureMessage, bRefreshAfter, ErrorText, bSilentSuccess, ChangedFiles]()
+		{
+			TSharedPtr<FSafeSaveStatusService> PinnedGame = SelfWeak.Pin();
+			if (!PinnedGame.IsValid() || PinnedGame->bIsShutDown)
+			{
+				return;
+			}
+
+			if (!(bSuccess && bSilentSuccess))
+			{
+				PinnedGame->Notify(bSuccess ? SuccessMessage : FailureMessage, bSuccess);
+			}
+			if (!bSuccess && !ErrorText.IsEmpty())
+			{
+				PinnedGame->Notify(FText::FromString(ErrorText.Left(200)), false);
+			}
+
+			if (ChangedFiles.Num() > 0)
+			{
+				PinnedGame->ReloadChangedPackages(ChangedFiles);
+			}
+
+			if (bRefreshAfter)
+			{
+				PinnedGame->RequestSourceControlStatusUpdate();
+				if (bSuccess)
+				{
+					PinnedGame->RequestLockRefresh();
+				}
+			}
+		});
+	});
+}
+
+bool FSafeSaveStatusService::ShouldReloadChangedPackages(bool bRequested) const
+{
+	const USafeSaveSettings* Settings = GetDefault<USafeSaveSettings>();
+	return bRequested && Settings && Settings->bReloadChangedPackagesAfterSync;
+}
+
+void FSafeSaveStatusService::ReloadChangedPackages(const TArray<FString>& ChangedFiles) const
+{
+	const FSafeSavePackageReloader::FResult Result = FSafeSavePackageReloader::ReloadChangedFiles(ChangedFiles);
+	UE_LOG(LogTemp, Log, TEXT("[SafeSave] %d changed files: rescanned %d packages, reloaded %d, skipped %d with unsaved changes."),
+		ChangedFiles.Num(), Result.NumRescanned, Result.NumReloaded, Result.NumSkippedDirty);
+
+	if (Result.NumSkippedDirty > 0)
+	{
+		Notify(FText::Format(LOCTEXT("ReloadSkippedDirty", "{0} changed assets have unsaved changes and were not reloaded."), FText::AsNumber(Result.NumSkippedDirty)), false);
+	}
+}
+
+void FSafeSaveStatusService::Notify(const FText& Message, bool bSuccess) const
+{
+	if (bIsShutDown)
+	{
+		return;
+	}
+
+	FNotificationInfo Info(Message);
+	Info.ExpireDuration = 4.0f;
+	Info.bUseLargeFont = false;
+	Info.bFireAndForget = true;
+	Info.Image = FAppStyle::GetBrush(bSuccess ? "Icons.Info" : "Icons.WarningWithColor");
+
+	TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Item.IsValid())
+	{
+		Item->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,284 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "SafeSaveFileStatusIndex.h"
+#include "SafeSaveLockIndex.h"
+#include "SafeSaveSourceControlStatus.h"
+#include "Styling/SlateColor.h"
+
+class FObjectPostSaveContext;
+class IAssetEditorInstance;
+class ISourceControlProvider;
+class FSafeSaveAutoFetch;
+class FSafeSaveCommandRunner;
+class FSafeSaveDetectionCache;
+class FSafeSaveDirtyPackageTracker;
+class FSafeSaveGitStatusQuery;
+class FSafeSaveLockTracker;
+class FSafeSavePackageFilter;
+class FSafeSavePlasticStatusQuery;
+class FSafeSavePollScheduler;
+class FSafeSaveRepositoryWatcher;
+class FSafeSaveSharedStatusCache;
+class FSafeSaveWorker;
+class UObject;
+class UPackage;
+struct FPropertyChangedEvent;
+struct FSlateBrush;
+
+/**
+ * Module-owned status collector. Polls dirty packages and source control once per editor and
+ * fans the result out to every SafeSave widget through OnStatusUpdated. Source control work runs
+ * on a private serialized worker thread.
+ */
+class FSafeSaveStatusService : public TSharedFromThis<FSafeSaveStatusService>
+{
+public:
+	FSafeSaveStatusService();
+	~FSafeSaveStatusService();
+
+	void Initialize();
+	void Shutdown();
+
+	/** Fired on the game thread whenever the source control status or unsaved state was refreshed. */
+	FSimpleMulticastDelegate& OnStatusUpdated() { return StatusUpdatedEvent; }
+
+	/** Status of the current snapshot. Game thread only; the reference is valid until the next snapshot is published. */
+	const FSafeSaveSourceControlStatus& GetStatusSnapshot() const { return CurrentSnapshot->Status; }
+
+	/**
+	 * Current snapshot of status and unsaved count; its version only moves on a real change. Any thread: the
+	 * snapshot is immutable and published by swapping the pointer, so holding it needs no further locking.
+	 */
+	FSafeSaveStatusSnapshotRef GetPublishedSnapshot() const;
+	/** Fired on the game thread when the published snapshot changed, not on every refresh. */
+	FOnSafeSaveStatusChanged& OnStatusChanged() { return StatusChangedEvent; }
+	/** Asks for a status refresh on the next tick; any number of requests before then share one query. */
+	void RequestCoalescedRefresh() { bCoalescedRefreshRequested = true; }
+
+	/** O(1) lookup of a package (e.g. /Game/Maps/Entry) in the last refresh's per-file index. Game thread only. */
+	ESafeSaveFileStatus GetPackageStatus(FName PackageName) const;
+	/** Lock on a package from the last lock refresh, or null. Answered from memory; game thread only. */
+	const FSafeSaveFileLock* FindPackageLock(FName PackageName) const;
+	bool HasUnsavedAssets() const { return bHasUnsavedAssets; }
+	int32 GetUnsavedAssetCount() const { return UnsavedAssetCount; }
+	const FString& GetSampleUnsavedPackage() const { return SampleUnsavedPackage; }
+
+	void UpdateUnsavedState();
+	/**
+	 * bAcceptSharedResult lets a recent result published by another editor on the same project stand in for
+	 * the query; pass false when something this process did may have changed the status.
+	 */
+	void RequestSourceControlStatusUpdate(bool bAcceptSharedResult = false);
+	/** Re-detects the repository and refreshes everything, as requested from the Refresh menu entry. */
+	void RefreshAll();
+	void ResetAutoFetchTimer();
+	/** Fetches the repository's whole lock list in the background; also runs periodically and after fetch, pull and push. */
+	void RequestLockRefresh();
+	/** The Save All menu entry: optionally drops byte-identical packages first, saves the rest in one batch, then refreshes once. */
+	void SaveAll();
+
+	/** Cached display state, rebuilt only when status or unsaved state changes; cheap to call every paint. */
+	const FSlateBrush* GetStatusIcon() const { return Presentation.Icon; }
+	const FText& GetStatusLabel() const { return Presentation.Label; }
+	const FSlateColor& GetStatusColor() const { return Presentation.Color; }
+	const FText& GetStatusTooltip() const { return Presentation.Tooltip; }
+	const FText& GetProviderLabel() const { return Presentation.ProviderLabel; }
+	/** Bumped each time the cached display state actually changes. */
+	uint32 GetPresentationVersion() const { return PresentationVersion; }
+	FString BuildStatusSummary(const FSafeSaveSourceControlStatus& Status) const;
+
+	bool CanExecuteGitCommand() const;
+	bool CanExecuteGitPull() const;
+	bool CanExecuteGitPush() const;
+	bool CanExecutePlasticUpdate() const;
+	/** Build gate checks (clean tree, no conflicts, up to date, no unsaved assets) that the current snapshot fails. */
+	TArray<FString> GetFailedSafetyChecks() const;
+	bool IsGitProvider() const;
+	bool IsPlasticProvider() const;
+
+	void RunGitCommandAsync(const FString& Args, const FText& SuccessMessage, const FText& FailureMessage, bool bRefreshAfter, bool bSilentSuccess = false, bool bReloadChangedPackages = false);
+	/** Background fetch for the auto-fetch timer; bFullFetch fetches every remote, otherwise only the current upstream when it moved. */
+	void RunAutoFetchAsync(bool bFullFetch);
+	void RunPlasticCommandAsync(const FString& Args, const FText& SuccessMessage, const FText& FailureMessage, bool bRefreshAfter, bool bSilentSuccess = false, bool bReloadChangedPackages = false);
+
+	void Notify(const FText& Message, bool bSuccess) const;
+
+	/**
+	 * Full status of the repository or workspace containing ProjectDir, queried on the calling thread without
+	 * touching the editor's state; None as PreferredProvider detects the provider. Any thread; calls for
+	 * different projects may run in parallel. Used by the SafeSaveStatus commandlet.
+	 */
+	static FSafeSaveSourceControlStatus QueryProjectStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider PreferredProvider = ESafeSaveSourceControlProvider::None);
+
+	/** Runs one provider's status query for ProjectDir on the calling thread, as the background refresh does. Used by the benchmarks. */
+	bool QueryProviderStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider Provider, FSafeSaveSourceControlStatus& OutStatus, FString& OutError) const;
+	/** Forgets the detected provider and repository root so the next query detects them again. */
+	void InvalidateDetectionCache() const;
+
+private:
+	/** A submodule or configured nested root queried alongside the main repository. */
+	struct FNestedRepository
+	{
+		FString Root;
+		ESafeSaveSourceControlProvider Provider = ESafeSaveSourceControlProvider::None;
+	};
+
+	/** Nested repositories discovered for one main repository root; rediscovered when detection is invalidated. */
+	struct FNestedRepositoryCache
+	{
+		bool bDiscovered = false;
+		FString RepoRoot;
+		uint32 SettingsHash = 0;
+		TArray<FNestedRepository> Repositories;
+	};
+
+	/** Main index merged with the nested repositories' entries, reused while neither side changed. */
+	struct FNestedIndexCache
+	{
+		FSafeSaveFileStatusIndexPtr MainIndex;
+		uint32 NestedChecksum = 0;
+		FSafeSaveFileStatusIndexPtr Combined;
+	};
+
+	/** Status processes of the nested repositories of one refresh, running while the main query runs. */
+	struct FNestedStatusBatch;
+
+	/** Label, tooltip, icon and color derived from the snapshot and unsaved state. */
+	struct FPresentation
+	{
+		const FSlateBrush* Icon = nullptr;
+		FSlateColor Color;
+		FText Label;
+		FText Tooltip;
+		FText ProviderLabel;
+		FString LabelString;
+		FString TooltipString;
+	};
+
+	bool Tick(float DeltaTime);
+	/** Configured status poll interval before the scheduler stretches or backs it off. */
+	double GetBaseStatusInterval() const;
+
+	void StartSourceControlStatusUpdate();
+	/** Asks the editor's provider for an asynchronous status update (or, with bRunUpdate false, only re-reads its cache). */
+	void StartEditorProviderStatusUpdate(const FString& ProviderName, bool bRunUpdate);
+	void FinishEditorProviderStatusUpdate(const FString& ProviderName);
+	/** Editor provider to read status from, or empty when SafeSave should run git or cm itself. */
+	FString GetEditorStatusProviderName() const;
+	/** Publishes a finished status query; game thread. */
+	void ApplySourceControlStatus(const FSafeSaveSourceControlStatus& NewStatus);
+	/** Shows the last session's status, if any, until the deferred first query has run. */
+	void RestoreLastKnownStatus();
+	/** Whether the editor has finished starting up (or waited long enough) for the deferred first query. */
+	bool IsEditorStartupComplete(double NowSeconds);
+	void HandlePostEngineInit();
+	/** Swaps in a snapshot of Status and the unsaved count, bumping the version and firing OnStatusChanged if either differs. */
+	void PublishSnapshot(const FSafeSaveSourceControlStatus& Status);
+	/** Rescans and reloads the packages a pull or update changed; game thread. */
+	void ReloadChangedPackages(const TArray<FString>& ChangedFiles) const;
+	bool ShouldReloadChangedPackages(bool bRequested) const;
+	/** Runs the status query for the project, on the worker thread. PreferredProvider comes from GetPreferredProvider. */
+	FSafeSaveSourceControlStatus QuerySourceControlStatus(const FString& ProjectDir, ESafeSaveSourceControlProvider PreferredProvider) const;
+	/** Settings that change what a status query returns; results shared by other processes must match them. */
+	uint32 GetSharedStatusSettingsHash() const;
+	/** Submodules of RepoRoot and the configured nested roots, which are relative to ProjectDir. */
+	TArray<FNestedRepository> GetNestedRepositories(const FString& RepoRoot, const FString& ProjectDir) const;
+	/** Starts the status command of every nested repository of RepoRoot without waiting for them. */
+	void LaunchNestedStatus(const FString& RepoRoot, const FString& ProjectDir, FNestedStatusBatch& Batch) const;
+	/** Waits for the batch and adds its counts and file entries to InOutStatus. */
+	void FinishNestedStatus(FNestedStatusBatch& Batch, FSafeSaveSourceControlStatus& InOutStatus) const;
+	/** Provider matching the editor's source control settings, if any. Game thread only, as it asks ISourceControlModule. */
+	ESafeSaveSourceControlProvider GetPreferredProvider() const;
+	void RefreshPresentation();
+	const FSlateBrush* BuildStatusIcon() const;
+	FText BuildStatusLabel() const;
+	FSlateColor BuildStatusColor() const;
+	FText BuildStatusTooltip() const;
+	FText BuildProviderLabel() const;
+	void MaybeNotifyStatusChange();
+	void UpdateRepositoryWatcher();
+	void HandleRepositoryChanged(bool bIndexOnly);
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	/** Save All with bSkipUnchangedOnSaveAll: prompts, compares the confirmed packages with disk and saves the changed ones. */
+	void SaveConfirmedChangedPackages();
+	void HandleSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent);
+	void HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void HandleSourceControlProviderChanged(ISourceControlProvider& OldProvider, ISourceControlProvider& NewProvider);
+	void HandleSourceControlStateChanged();
+	void HandleAssetOpened(UObject* Asset, IAssetEditorInstance* EditorInstance);
+	/** Toasts when Package is locked by someone else, once per package and owner. */
+	void WarnIfLockedByOthers(const UPackage* Package);
+
+	/** Written on the game thread only; other threads copy the pointer under SnapshotLock. */
+	FSafeSaveStatusSnapshotRef CurrentSnapshot = MakeShared<FSafeSaveStatusSnapshot, ESPMode::ThreadSafe>();
+	mutable FCriticalSection SnapshotLock;
+	/** Runs git and cm for every query and command; declared before everything that holds a reference to it. */
+	TUniquePtr<FSafeSaveCommandRunner> CommandRunner;
+	TUniquePtr<FSafeSaveDetectionCache> DetectionCache;
+	TUniquePtr<FSafeSaveGitStatusQuery> GitQuery;
+	TUniquePtr<FSafeSavePlasticStatusQuery> PlasticQuery;
+	TUniquePtr<FSafeSaveLockTracker> LockTracker;
+	TUniquePtr<FSafeSaveAutoFetch> AutoFetch;
+	mutable FNestedRepositoryCache NestedRepositoryCache;
+	mutable FNestedIndexCache NestedIndexCache;
+	mutable FCriticalSection NestedCacheLock;
+	bool bHasUnsavedAssets = false;
+	int32 UnsavedAssetCount = 0;
+	FString SampleUnsavedPackage;
+	FString LastStatusLabel;
+	FPresentation Presentation;
+	uint32 PresentationVersion = 0;
+	TUniquePtr<FSafeSaveDirtyPackageTracker> DirtyPackageTracker;
+	/** Which dirty packages count as unsaved; recompiled when the rules in the settings change. */
+	TSharedPtr<const FSafeSavePackageFilter> PackageFilter;
+	TUniquePtr<FSafeSaveRepositoryWatcher> RepositoryWatcher;
+	TUniquePtr<FSafeSavePollScheduler> PollScheduler;
+	/** Runs every status query and git/cm command, in order, off the engine thread pool. */
+	TUniquePtr<FSafeSaveWorker> Worker;
+	TUniquePtr<FSafeSaveSharedStatusCache> SharedStatusCache;
+	FSimpleMulticastDelegate StatusUpdatedEvent;
+	FOnSafeSaveStatusChanged StatusChangedEvent;
+	bool bCoalescedRefreshRequested = false;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle SettingsChangedHandle;
+	FDelegateHandle PackageMarkedDirtyHandle;
+	FDelegateHandle AssetOpenedHandle;
+	FDelegateHandle ProviderChangedHandle;
+	FDelegateHandle SourceControlStateChangedHandle;
+	FDelegateHandle PostEngineInitHandle;
+	/** An FUpdateStatus for SafeSave is running in the editor's provider. */
+	bool bEditorUpdatePending = false;
+	/** The provider's cached states changed (e.g. the content browser refreshed them); re-read them without a query. */
+	bool bEditorStatesChanged = false;
+
+	double LastDirtyCheckSeconds = 0.0;
+	double LastDirtyReconcileSeconds = 0.0;
+	double LastSourceControlCheckSeconds = 0.0;
+	double LastStatusToastSeconds = 0.0;
+	double LastRepositoryChangeSeconds = 0.0;
+	/** Last local event that may have changed the status; shared results from queries started earlier are not used. */
+	FDateTime LastStatusInvalidationUtc;
+
+	TAtomic<bool> bStatusUpdateInFlight = false;
+	/** Bumped by every status request; the in-flight query reruns once if it has moved on since the query started. */
+	uint32 StatusRequestGeneration = 0;
+	uint32 StatusStartedGeneration = 0;
+	bool bHasSeenStatusLabel = false;
+	bool bRepositoryChangePending = false;
+	/** An index-only change arrived while our own status ran; checked against the index it left once it is done. */
+	bool bIndexChangedDuringStatus = false;
+	/** The first query waits for the editor to finish starting up; see bDeferStartupRefresh. */
+	bool bStartupRefreshPending = false;
+	bool bEngineInitComplete = false;
+	double StartupSeconds = 0.0;
+	/** When the editor was last seen done with startup work; reset while it is busy again. */
+	double StartupIdleSinceSeconds = 0.0;
+	/** Saves during SaveAll do not schedule refreshes of their own. */
+	bool bSaveAllInProgress = false;
+	bool bIsShutDown = false;
+};
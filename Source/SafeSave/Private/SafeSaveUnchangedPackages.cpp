@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveUnchangedPackages.h"
+
+#include "SafeSaveStats.h"
+
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#define LOCTEXT_NAMESPACE "SafeSaveToolbar"
+
+FSafeSaveUnchangedPackages::FResult FSafeSaveUnchangedPackages::ClearUnchanged(const TArray<UPackage*>& Packages)
+{
+	SAFESAVE_SCOPE(STAT_SafeSave_ClearUnchangedPackages, FSafeSaveUnchangedPackages::ClearUnchanged);
+
+	FResult Result;
+	const FString ScratchDir = FPaths::ProjectSavedDir() / TEXT("SafeSave/SaveCompare");
+
+	FScopedSlowTask SlowTask((float)Packages.Num(), LOCTEXT("ComparingPackages", "Checking which packages changed..."));
+	SlowTask.MakeDialogDelayed(0.5f, true);
+
+	TArray<UPackage*> IdenticalPackages;
+	for (UPackage* Package : Packages)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			Result.bCancelled = true;
+			break;
+		}
+		SlowTask.EnterProgressFrame(1.0f);
+
+		if (Package && Package->IsDirty() && IsIdenticalToDisk(Package, ScratchDir))
+		{
+			IdenticalPackages.Add(Package);
+		}
+		else if (Package)
+		{
+			Result.ChangedPackages.Add(Package);
+		}
+	}
+
+	IFileManager::Get().DeleteDirectory(*ScratchDir, false, true);
+
+	// A cancelled Save All leaves every package as the user had it.
+	if (Result.bCancelled)
+	{
+		Result.ChangedPackages.Reset();
+		return Result;
+	}
+
+	for (UPackage* Package : IdenticalPackages)
+	{
+		Package->SetDirtyFlag(false);
+	}
+	Result.NumSkipped = IdenticalPackages.Num();
+	Result.NumChanged = Result.ChangedPackages.Num();
+	return Result;
+}
+
+bool FSafeSaveUnchangedPackages::IsIdenticalToDisk(UPackage* Package, const FString& ScratchDir)
+{
+	FString ExistingFile;
+	if (!FPackageName::DoesPackageExist(Package->GetName(), &ExistingFile))
+	{
+		return false;
+	}
+
+	const FString ScratchFile = FPaths::CreateTempFilename(*ScratchDir, TEXT("Compare"), *FPaths::GetExtension(ExistingFile, true));
+
+	// Autosave semantics: write elsewhere without touching the package's loaded path, linker or dirty flag.
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError | SAVE_KeepDirty | SAVE_FromAutosave;
+	SaveArgs.Error = GWarn;
+
+	UObject* Asset = UWorld::FindWorldInPackage(Package);
+	const bool bSaved = UPackage::SavePackage(Package, Asset, *ScratchFile, SaveArgs);
+
+	bool bIdentical = false;
+	IFileManager& FileManager = IFileManager::Get();
+	if (bSaved && FileManager.FileSize(*ScratchFile) == FileManager.FileSize(*ExistingFile))
+	{
+		bIdentical = FMD5Hash::HashFile(*ScratchFile) == FMD5Hash::HashFile(*ExistingFile);
+	}
+
+	FileManager.Delete(*ScratchFile, false, true, true);
+	return bIdentical;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+
+/**
+ * Finds dirty packages whose serialized content is byte-identical to the file on disk, e.g. after an
+ * operation that called Modify() without changing anything. Each candidate is saved to a scratch file the
+ * way autosave does (the package keeps its path and dirty flag) and hashed against the existing file.
+ */
+class FSafeSaveUnchangedPackages
+{
+public:
+	struct FResult
+	{
+		/** Packages that matched their file and had their dirty flag cleared. */
+		int32 NumSkipped = 0;
+		/** Packages that were compared and differ, never saved, or could not be compared. */
+		int32 NumChanged = 0;
+		/** Packages still dirty afterwards, in their original order. */
+		TArray<UPackage*> ChangedPackages;
+		bool bCancelled = false;
+	};
+
+	/**
+	 * Compares every package in Packages with its file and clears the dirty flag of identical ones. Nothing is
+	 * cleared when the comparison is cancelled. Game thread only.
+	 */
+	static FResult ClearUnchanged(const TArray<UPackage*>& Packages);
+
+private:
+	static bool IsIdenticalToDisk(UPackage* Package, const FString& ScratchDir);
+};
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SafeSaveWorker.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FSafeSaveWorker::FSafeSaveWorker()
+{
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("SafeSaveWorker"), 0, TPri_BelowNormal);
+}
+
+FSafeSaveWorker::~FSafeSaveWorker()
+{
+	StopAndWait();
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+bool FSafeSaveWorker::Enqueue(TUniqueFunction<void()>&& Job)
+{
+	if (bStopping.Load() || !Thread)
+	{
+		return false;
+	}
+
+	++PendingJobs;
+	Jobs.Enqueue(MoveTemp(Job));
+	WorkEvent->Trigger();
+	return true;
+}
+
+void FSafeSaveWorker::StopAndWait()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	// Kill calls Stop and then joins the thread.
+	Thread->Kill(true);
+	delete Thread;
+	Thread = nullptr;
+
+	TUniqueFunction<void()> Discarded;
+	while (Jobs.Dequeue(Discarded))
+	{
+		--PendingJobs;
+	}
+}
+
+uint32 FSafeSaveWorker::Run()
+{
+	while (!bStopping.Load())
+	{
+		TUniqueFunction<void()> Job;
+		if (!Jobs.Dequeue(Job))
+		{
+			WorkEvent->Wait();
+			continue;
+		}
+
+		Job();
+		--PendingJobs;
+	}
+
+	return 0;
+}
+
+void FSafeSaveWorker::Stop()
+{
+	bStopping = true;
+	WorkEvent->Trigger();
+}
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+
+class FRunnableThread;
+
+/**
+ * A single below-normal priority thread that runs SafeSave's source control jobs one at a time in the
+ * order they were queued. Git and cm calls block for as long as the tool runs, so they are kept off the
+ * engine thread pool, and a fetch queued before a status query always finishes before that query starts.
+ */
+class FSafeSaveWorker : public FRunnable
+{
+public:
+	FSafeSaveWorker();
+	virtual ~FSafeSaveWorker() override;
+
+	/** Queues Job behind everything already queued. Returns false (and drops Job) once the worker is stopping. */
+	bool Enqueue(TUniqueFunction<void()>&& Job);
+
+	/** Discards jobs that have not started and waits for the running one to return. */
+	void StopAndWait();
+
+	/** Jobs queued or running; read from any thread, so only approximate. */
+	int32 GetPendingJobCount() const { return PendingJobs.Load(); }
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Jobs;
+	FEvent* WorkEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	TAtomic<int32> PendingJobs = 0;
+	TAtomic<bool> bStopping = false;
+};
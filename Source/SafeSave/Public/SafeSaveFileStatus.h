@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Source control state of a single file, as reported by the last status refresh. */
+enum class ESafeSaveFileStatus : uint8
+{
+	None = 0,
+	/** Changes are staged in the index (Git only). */
+	Staged = 1 << 0,
+	/** Work tree differs from the index (Git) or the file is checked out/changed (Plastic). */
+	Modified = 1 << 1,
+	Untracked = 1 << 2,
+	Conflicted = 1 << 3,
+};
+ENUM_CLASS_FLAGS(ESafeSaveFileStatus);
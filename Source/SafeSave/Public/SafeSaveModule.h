@@ -4,15 +4,61 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "SafeSaveFileStatus.h"
+#include "SafeSaveSourceControlStatus.h"
 
-class FSafeSaveModule : public IModuleInterface
+class FSafeSaveStatusService;
+
+class SAFESAVE_API FSafeSaveModule : public IModuleInterface
 {
 public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+	static FSafeSaveModule& Get()
+	{
+		return FModuleManager::GetModuleChecked<FSafeSaveModule>("SafeSave");
+	}
+
+	/** Editor-wide status collector shared by every SafeSave widget. */
+	TSharedPtr<FSafeSaveStatusService> GetStatusService() const { return StatusService; }
+
+	/**
+	 * Whether a package is modified, staged, conflicted or untracked according to the last status refresh.
+	 * Answered from an in-memory index in O(1); never runs a source control query. Game thread only.
+	 */
+	ESafeSaveFileStatus GetPackageStatus(FName PackageName) const;
+
+	/**
+	 * Whether a package is locked (Git LFS or Plastic) and by whom, according to the last lock refresh.
+	 * Answered from memory; never contacts the server. Game thread only.
+	 */
+	bool GetPackageLock(FName PackageName, FString& OutOwner, bool& bOutOwnedByCurrentUser) const;
+
+	/**
+	 * Last published status: branch, ahead/behind, change counts and unsaved assets, with a version that only
+	 * increases when something in it changed. Use instead of running git or cm. Any thread; the snapshot is
+	 * immutable, so it can be kept and read without copying or locking.
+	 */
+	FSafeSaveStatusSnapshotRef GetStatusSnapshot() const;
+
+	/** Fired on the game thread when the snapshot changed; a refresh that found nothing new does not fire it. */
+	FOnSafeSaveStatusChanged& OnStatusChanged();
+
+	/** Asks for a fresh status query. Requests made until the next editor tick are coalesced into one query. */
+	void RequestStatusRefresh();
+
+	/**
+	 * Reasons the last published status fails the SafeSave gate (local changes, conflicts, behind upstream,
+	 * unsaved assets); empty when it passes. Lets an in-editor cook or PIE launch refuse to start on the same
+	 * rules as the SafeSaveStatus commandlet. Game thread only.
+	 */
+	TArray<FString> GetFailedSafetyChecks() const;
+
 private:
 	/** Registers the SafeSave status widget into the main Level Editor Toolbar. */
 	void RegisterMenus();
+
+	TSharedPtr<FSafeSaveStatusService> StatusService;
 };
@@ -6,6 +6,49 @@
 #include "Engine/DeveloperSettings.h"
 #include "SafeSaveSettings.generated.h"
 
+UENUM()
+enum class ESafeSaveGitBackend : uint8
+{
+	/** Every query runs the git CLI (rev-parse and status). */
+	ProcessPerQuery UMETA(DisplayName = "Git CLI"),
+
+	/** Repository root, branch, upstream and commit ids are read from .git in-process; only the working tree scan runs git. */
+	InProcessMetadata UMETA(DisplayName = "In-Process Metadata"),
+};
+
+UENUM()
+enum class ESafeSaveStatusSource : uint8
+{
+	/** SafeSave always runs git or cm itself. */
+	CommandLine UMETA(DisplayName = "Git / cm Command Line"),
+
+	/** The editor's source control provider's cached file states, refreshed by its own asynchronous status update; falls back to the command line when no provider is enabled. */
+	EditorProvider UMETA(DisplayName = "Editor Source Control When Enabled"),
+};
+
+UENUM()
+enum class ESafeSaveGitStatusScanMode : uint8
+{
+	/** Plain `git status`, scanning the whole work tree including untracked files. */
+	Full UMETA(DisplayName = "Full Scan"),
+
+	/** Enables core.untrackedCache and the built-in core.fsmonitor daemon where the installed git supports them. */
+	Accelerated UMETA(DisplayName = "Untracked Cache + FSMonitor"),
+
+	/** Tracked files only on every poll (--untracked-files=no); untracked files are counted on a slower interval. */
+	TrackedOnly UMETA(DisplayName = "Tracked Only + Periodic Untracked Scan"),
+};
+
+UENUM()
+enum class ESafeSaveAutoFetchMode : uint8
+{
+	/** `git fetch --prune`: every branch and tag of every remote. */
+	AllRemotes UMETA(DisplayName = "All Remotes"),
+
+	/** Checks the current branch's upstream with ls-remote and fetches only that ref (no tags) when it moved. */
+	UpstreamOnly UMETA(DisplayName = "Current Upstream Only"),
+};
+
 UCLASS(config = EditorPerProjectUserSettings, defaultconfig, meta = (DisplayName = "SafeSave"))
 class SAFESAVE_API USafeSaveSettings : public UDeveloperSettings
 {
@@ -14,24 +57,173 @@ class SAFESAVE_API USafeSaveSettings : public UDeveloperSettings
 public:
 	USafeSaveSettings();
 
+	/**
+	 * Show the last session's status (marked stale) at startup and run the first query only once the editor has
+	 * finished starting up and the asset registry has loaded, so SafeSave adds nothing to editor startup.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Defer Startup Refresh"))
+	bool bDeferStartupRefresh;
+
 	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "0.1", UIMin = "0.1"))
 	float DirtyCheckIntervalSeconds;
 
+	/** Track dirty packages from package events instead of scanning every loaded package on each dirty check. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Event-Driven Dirty Tracking"))
+	bool bEventDrivenDirtyTracking;
+
+	/** How often the event-driven tracker runs a full sweep to correct drift. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "5.0", UIMin = "5.0", EditCondition = "bEventDrivenDirtyTracking", DisplayName = "Dirty Reconcile Interval (Seconds)"))
+	float DirtyReconcileIntervalSeconds;
+
+	/** Only dirty packages under these paths count as unsaved (e.g. /Game/). Empty counts every path not excluded. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Unsaved Include Paths"))
+	TArray<FString> UnsavedIncludePaths;
+
+	/** Dirty packages under these paths are ignored. The longest matching include or exclude path wins. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Unsaved Exclude Paths"))
+	TArray<FString> UnsavedExcludePaths;
+
+	/** Dirty packages whose name contains any of these strings are ignored (editor-generated instance packages). */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Unsaved Exclude Name Markers"))
+	TArray<FString> UnsavedExcludeNameMarkers;
+
+	/** Stretch poll intervals while the editor is in the background, idle or playing in editor, and back off while queries keep failing. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (DisplayName = "Adaptive Polling"))
+	bool bAdaptivePolling;
+
+	/** Interval multiplier while the editor is unfocused, idle or running a commandlet. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "1.0", UIMin = "1.0", EditCondition = "bAdaptivePolling"))
+	float BackgroundIntervalMultiplier;
+
+	/** Interval multiplier while a Play In Editor session is running. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "1.0", UIMin = "1.0", EditCondition = "bAdaptivePolling", DisplayName = "PIE Interval Multiplier"))
+	float PlayInEditorIntervalMultiplier;
+
+	/** Treat the focused editor as idle after this long without keyboard or mouse input. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "30.0", UIMin = "30.0", EditCondition = "bAdaptivePolling", DisplayName = "Idle Threshold (Seconds)"))
+	float IdleThresholdSeconds;
+
+	/** Upper bound of the exponential backoff applied while source control queries keep failing. */
+	UPROPERTY(EditAnywhere, config, Category = "Status", meta = (ClampMin = "10.0", UIMin = "10.0", EditCondition = "bAdaptivePolling", DisplayName = "Max Failure Backoff (Seconds)"))
+	float MaxFailureBackoffSeconds;
+
 	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "1.0", UIMin = "1.0", DisplayName = "Status Poll Interval (Seconds)"))
 	float GitCheckIntervalSeconds;
 
+	/** Where status comes from. The editor's provider avoids duplicate queries and also covers Perforce and other providers. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Status Source"))
+	ESafeSaveStatusSource StatusSource;
+
+	/** Editors and commandlets on the same project take turns querying and reuse each other's recent results. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Share Status Across Processes"))
+	bool bShareStatusAcrossProcesses;
+
+	/** Age up to which another process's status result is used instead of running the query again. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "1.0", UIMin = "1.0", EditCondition = "bShareStatusAcrossProcesses", DisplayName = "Shared Status Max Age (Seconds)"))
+	float SharedStatusMaxAgeSeconds;
+
+	/** How Git repository metadata is read. In-process reads HEAD and refs from .git instead of spawning git for them. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Git Backend"))
+	ESafeSaveGitBackend GitBackend;
+
+	/** How `git status` scans the work tree. Non-full modes keep status cost proportional to changes on very large repositories. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Git Status Scan Mode"))
+	ESafeSaveGitStatusScanMode GitStatusScanMode;
+
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "10.0", UIMin = "10.0", EditCondition = "GitStatusScanMode == ESafeSaveGitStatusScanMode::TrackedOnly", DisplayName = "Untracked Scan Interval (Seconds)"))
+	float UntrackedScanIntervalSeconds;
+
+	/** Include changes in initialized git submodules of the project's repository in the status counts. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Include Submodules (Git Only)"))
+	bool bIncludeSubmodules;
+
+	/** Further git repositories or Plastic workspaces (relative to the project directory, or absolute) whose changes are added to the status. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Nested Repository Roots"))
+	TArray<FString> NestedRepositoryRoots;
+
+	/** Limit status queries to StatusScopePaths instead of the whole repository or workspace, e.g. for a project inside a monorepo. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Scope Status To Project Paths"))
+	bool bScopeStatusToPaths;
+
+	/**
+	 * Folders or files, relative to the project directory (or absolute), passed to git as pathspecs.
+	 * Plastic status accepts a single path, so it is scoped to the project directory instead.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (EditCondition = "bScopeStatusToPaths", DisplayName = "Status Scope Paths"))
+	TArray<FString> StatusScopePaths;
+
+	/**
+	 * Run status with --no-ahead-behind and count ahead/behind with a separate rev-list only when HEAD or the
+	 * upstream commit changed. Avoids a history walk on every poll for branches far from their upstream.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Lazy Ahead/Behind (Git Only)"))
+	bool bLazyAheadBehind;
+
+	/** Refresh Git status when HEAD, the index or refs change on disk, or when a package is saved, instead of on every poll. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Watch Repository For Changes (Git Only)"))
+	bool bWatchRepositoryForChanges;
+
+	/** Poll interval used as a safety net while the repository watcher is active. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "5.0", UIMin = "5.0", EditCondition = "bWatchRepositoryForChanges", DisplayName = "Watched Safety Net Interval (Seconds)"))
+	float WatcherSafetyNetIntervalSeconds;
+
+	/** Keep one `cm shell` session alive and send Plastic status queries through it instead of starting cm for each one. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Persistent cm Shell (Plastic Only)"))
+	bool bPersistentPlasticShell;
+
+	/** Git or cm status queries still running after this long are killed and reported as failed. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "5.0", UIMin = "5.0", DisplayName = "Status Query Timeout (Seconds)"))
+	float StatusQueryTimeoutSeconds;
+
+	/** Timeout for fetch, pull, push and update, which talk to the server and may legitimately take longer. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "10.0", UIMin = "10.0", DisplayName = "Remote Command Timeout (Seconds)"))
+	float RemoteCommandTimeoutSeconds;
+
 	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Auto Fetch (Git Only)"))
 	bool bAutoFetch;
 
 	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "10.0", UIMin = "10.0", EditCondition = "bAutoFetch", DisplayName = "Auto Fetch Interval (Seconds, Git Only)"))
 	float AutoFetchIntervalSeconds;
 
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (EditCondition = "bAutoFetch", DisplayName = "Auto Fetch Mode (Git Only)"))
+	ESafeSaveAutoFetchMode AutoFetchMode;
+
+	/** In upstream-only mode, run a full `fetch --prune` at this much longer interval. 0 disables it. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bAutoFetch && AutoFetchMode == ESafeSaveAutoFetchMode::UpstreamOnly", DisplayName = "Full Fetch Interval (Seconds, Git Only)"))
+	float FullFetchIntervalSeconds;
+
+	/** After Pull or Update, rescan and reload only the packages the pull or update changed. */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Reload Changed Packages After Pull/Update"))
+	bool bReloadChangedPackagesAfterSync;
+
+	/**
+	 * Keep the repository's Git LFS or Plastic locks in memory, fetched in one batched call per refresh. Each call
+	 * is a server round-trip; after repeated failures (e.g. no LFS locking on the remote) it stops for the session.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (DisplayName = "Query Locks (Git LFS / Plastic)"))
+	bool bQueryLocks;
+
+	UPROPERTY(EditAnywhere, config, Category = "Source Control", meta = (ClampMin = "30.0", UIMin = "30.0", EditCondition = "bQueryLocks", DisplayName = "Lock Refresh Interval (Seconds)"))
+	float LockRefreshIntervalSeconds;
+
+	/**
+	 * Save All compares each package confirmed in its prompt with the file on disk and only clears the dirty flag
+	 * of identical ones. Each compared package is serialized once more, so this costs extra writes for packages
+	 * that did change.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Saving", meta = (DisplayName = "Skip Unchanged Packages On Save All"))
+	bool bSkipUnchangedOnSaveAll;
+
 	UPROPERTY(EditAnywhere, config, Category = "Notifications")
 	bool bToastOnStatusChange;
 
 	UPROPERTY(EditAnywhere, config, Category = "Notifications", meta = (ClampMin = "0.5", UIMin = "0.5"))
 	float StatusToastMinIntervalSeconds;
 
+	/** Show a toast when an asset locked by someone else is opened or modified. */
+	UPROPERTY(EditAnywhere, config, Category = "Notifications", meta = (EditCondition = "bQueryLocks", DisplayName = "Warn On Locked Assets"))
+	bool bWarnOnLockedAssets;
+
 	virtual FName GetCategoryName() const override
 	{
 		return FName("Plugins");
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Delegates/Delegate.h"
+
+class FSafeSaveFileStatusIndex;
+
+enum class ESafeSaveSourceControlProvider : uint8
+{
+	None,
+	Git,
+	Plastic
+};
+
+/** Result of one source control status refresh. Copies are cheap; the per-file index is shared. */
+struct FSafeSaveSourceControlStatus
+{
+	ESafeSaveSourceControlProvider Provider = ESafeSaveSourceControlProvider::None;
+	bool bClientAvailable = false;
+	bool bRepo = false;
+	bool bAuthRequired = false;
+	bool bHasUpstream = false;
+	bool bHasConflicts = false;
+	int32 Ahead = 0;
+	int32 Behind = 0;
+	int32 Staged = 0;
+	int32 Unstaged = 0;
+	int32 Untracked = 0;
+	FString Branch;
+	/** Commit ids of HEAD and its upstream, when known (Git only). */
+	FString HeadCommit;
+	FString UpstreamCommit;
+	FString RepoRoot;
+	FString WorkspaceName;
+	FString LastError;
+	FString ScanMode;
+	/** Editor source control provider the status was read from; empty when SafeSave ran git or cm itself. */
+	FString EditorProviderName;
+	FDateTime LastUpdateUtc;
+	/** Restored from the previous editor session and not yet confirmed by a live query. */
+	bool bStale = false;
+	/** Submodules and configured nested roots whose changes are included in the counts, and how many of them failed to answer. */
+	int32 NestedRepositories = 0;
+	int32 NestedRepositoriesFailed = 0;
+	/** Per-package state; shared and immutable, so copying the status does not copy the index. */
+	TSharedPtr<const FSafeSaveFileStatusIndex, ESPMode::ThreadSafe> FileIndex;
+};
+
+/** What SafeSave currently knows, as published to other tools through FSafeSaveModule. Immutable once published. */
+struct FSafeSaveStatusSnapshot
+{
+	/** Increases with every published change, so a consumer can tell whether it has seen this state. 0 before the first. */
+	uint64 Version = 0;
+	FSafeSaveSourceControlStatus Status;
+	/** Dirty packages that count as unsaved under the configured filters. */
+	int32 UnsavedAssetCount = 0;
+};
+
+using FSafeSaveStatusSnapshotRef = TSharedRef<const FSafeSaveStatusSnapshot, ESPMode::ThreadSafe>;
+
+/** Fired on the game thread when the published snapshot changed. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSafeSaveStatusChanged, const FSafeSaveStatusSnapshot& /*Snapshot*/);
@@ -14,8 +14,12 @@ public class SafeSave : ModuleRules
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
 			"Projects",
+			"AssetRegistry",
 			"CoreUObject",
+			"DirectoryWatcher",
 			"Engine",
+			"Json",
+			"PackagesDialog",
 			"Slate",
 			"SlateCore",
 			"Settings",